@@ -90,8 +90,10 @@ function rados_put() {
     local poolname=$2
     local objname=${3:-SOMETHING}
 
+    # span every data chunk of a k=2 stripe, so that a get has to read
+    # more than the one shard a sub-chunk read is served from
     for marker in AAA BBB CCCC DDDD ; do
-        printf "%*s" 1024 $marker
+        printf "%*s" 2048 $marker
     done > $dir/ORIGINAL
     #
     # get and put an object, compare they are equal
@@ -353,6 +355,38 @@ function TEST_rados_get_with_subreadall_eio_shard_1() {
     delete_erasure_coded_pool $poolname
 }
 
+# A read that fits inside one data chunk is served by the shard holding
+# that chunk alone, so it succeeds even when every other shard fails
+function TEST_rados_get_sub_chunk_eio_other_shards() {
+    local dir=$1
+    setup_osds 4 || return 1
+
+    local poolname=pool-jerasure
+    create_erasure_coded_pool $poolname 2 1 || return 1
+    local objname=obj-sub-chunk-$$
+
+    # smaller than one chunk with the default stripe unit
+    for marker in AAA BBB CCCC DDDD ; do
+        printf "%*s" 1024 $marker
+    done > $dir/ORIGINAL
+    rados --pool $poolname put $objname $dir/ORIGINAL || return 1
+
+    # the second data shard and the parity shard both fail to read
+    inject_eio ec data $poolname $objname $dir 1 || return 1
+    inject_eio ec data $poolname $objname $dir 2 || return 1
+    rados_get $dir $poolname $objname || return 1
+
+    local primary=$(get_primary $poolname $objname)
+    CEPH_ARGS='' ceph --admin-daemon $(get_asok_path osd.$primary) log flush || return 1
+    grep -q "reads only chunk 0" $dir/osd.$primary.log || return 1
+
+    # losing the shard that holds the chunk as well leaves too few to decode
+    inject_eio ec data $poolname $objname $dir 0 || return 1
+    rados_get $dir $poolname $objname fail || return 1
+    rm $dir/ORIGINAL
+    delete_erasure_coded_pool $poolname
+}
+
 # Test recovery the object attr read error
 function TEST_ec_object_attr_read_error() {
     local dir=$1
@@ -412,6 +446,39 @@ function TEST_ec_single_recovery_error() {
     delete_erasure_coded_pool $poolname
 }
 
+# Repair a single lost shard of a clay object much smaller than the
+# recovery chunk: the helpers read sub-chunks past the end of their shard
+function TEST_ec_clay_recovery_small_object() {
+    local dir=$1
+    local objname=myobject
+
+    setup_osds 7 || return 1
+
+    local poolname=pool-clay
+    ceph osd erasure-code-profile set myprofile \
+        plugin=clay \
+        k=4 m=2 d=5 \
+        crush-failure-domain=osd || return 1
+    create_pool $poolname 1 1 erasure myprofile || return 1
+    wait_for_clean || return 1
+
+    rados_put $dir $poolname $objname || return 1
+
+    local -a initial_osds=($(get_osds $poolname $objname))
+    local last_osd=${initial_osds[-1]}
+    # Kill OSD
+    kill_daemons $dir TERM osd.${last_osd} >&2 < /dev/null || return 1
+    ceph osd down ${last_osd} || return 1
+    ceph osd out ${last_osd} || return 1
+
+    # Cluster should recover this object without crashing the helpers
+    wait_for_clean || return 1
+
+    rados_get $dir $poolname $objname || return 1
+
+    delete_erasure_coded_pool $poolname
+}
+
 # Test recovery when repeated reads are needed due to EIO
 function TEST_ec_recovery_multiple_errors() {
     local dir=$1
@@ -8,16 +8,12 @@
 #include "liburing.h"
 #include <sys/epoll.h>
 
-/* Options */
-
-static bool hipri = false;      /* use IO polling */
-static bool sq_thread = false;  /* use kernel submission/poller thread */
-
 struct ioring_data {
   struct io_uring io_uring;
   pthread_mutex_t cq_mutex;
   pthread_mutex_t sq_mutex;
   int epoll_fd = -1;
+  bool ext_arg = false;  // kernel takes the wait timeout in io_uring_enter
   std::map<int, int> fixed_fds_map;
 };
 
@@ -73,30 +69,54 @@ static void init_sqe(struct ioring_data *d, struct io_uring_sqe *sqe,
 }
 
 static int ioring_queue(struct ioring_data *d, void *priv,
-			list<aio_t>::iterator beg, list<aio_t>::iterator end)
+			list<aio_t>::iterator beg, list<aio_t>::iterator end,
+			int *retries)
 {
+  // 2^16 * 125us = ~8 seconds, so max sleep is ~16 seconds
+  int attempts = 16;
+  int delay = 125;
   struct io_uring *ring = &d->io_uring;
-  struct aio_t *io = nullptr;
+  int submitted = 0;
 
   ceph_assert(beg != end);
 
-  do {
-    struct io_uring_sqe *sqe = io_uring_get_sqe(ring);
-    if (!sqe)
+  while (beg != end) {
+    // fill as many SQEs as the ring has room for, then hand all of them
+    // to the kernel with a single io_uring_enter(2)
+    unsigned queued = 0;
+    do {
+      struct io_uring_sqe *sqe = io_uring_get_sqe(ring);
+      if (!sqe)
+	break;
+
+      struct aio_t *io = &*beg;
+      io->priv = priv;
+
+      init_sqe(d, sqe, io);
+      ++queued;
+    } while (++beg != end);
+
+    if (queued) {
+      int r = io_uring_submit(ring);
+      if (r < 0)
+	return r;
+      submitted += r;
+      attempts = 16;
+      delay = 125;
+    }
+    if (beg == end)
       break;
 
-    io = &*beg;
-    io->priv = priv;
-
-    init_sqe(d, sqe, io);
-
-  } while (++beg != end);
-
-  if (!io)
-    /* Queue is full, go and reap something first */
-    return 0;
+    /* SQ is full (e.g. the SQPOLL thread has not caught up yet); back off
+     * and retry instead of dropping the rest of the batch on the floor. */
+    if (attempts-- <= 0)
+      return -EAGAIN;
+    usleep(delay);
+    delay *= 2;
+    (*retries)++;
+  }
 
-  return io_uring_submit(ring);
+  return submitted;
 }
 
 static void build_fixed_fds_map(struct ioring_data *d,
@@ -108,9 +128,11 @@ static void build_fixed_fds_map(struct ioring_data *d,
   }
 }
 
-ioring_queue_t::ioring_queue_t(unsigned iodepth_) :
+ioring_queue_t::ioring_queue_t(unsigned iodepth_, bool hipri_, bool sq_thread_) :
   d(make_unique<ioring_data>()),
-  iodepth(iodepth_)
+  iodepth(iodepth_),
+  hipri(hipri_),
+  sq_thread(sq_thread_)
 {
 }
 
@@ -130,9 +152,15 @@ int ioring_queue_t::init(std::vector<int> &fds)
   if (sq_thread)
     flags |= IORING_SETUP_SQPOLL;
 
-  int ret = io_uring_queue_init(iodepth, &d->io_uring, flags);
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  params.flags = flags;
+  int ret = io_uring_queue_init_params(iodepth, &d->io_uring, &params);
   if (ret < 0)
     return ret;
+#ifdef IORING_FEAT_EXT_ARG
+  d->ext_arg = params.features & IORING_FEAT_EXT_ARG;
+#endif
 
   ret = io_uring_register(d->io_uring.ring_fd, IORING_REGISTER_FILES,
 			  &fds[0], fds.size());
@@ -180,10 +208,9 @@ int ioring_queue_t::submit_batch(aio_iter beg, aio_iter end,
                                  int *retries)
 {
   (void)aios_size;
-  (void)retries;
 
   pthread_mutex_lock(&d->sq_mutex);
-  int rc = ioring_queue(d.get(), priv, beg, end);
+  int rc = ioring_queue(d.get(), priv, beg, end, retries);
   pthread_mutex_unlock(&d->sq_mutex);
 
   return rc;
@@ -197,13 +224,51 @@ get_cqe:
   pthread_mutex_unlock(&d->cq_mutex);
 
   if (events == 0) {
-    struct epoll_event ev;
-    int ret = epoll_wait(d->epoll_fd, &ev, 1, timeout_ms);
-    if (ret < 0)
-      events = -errno;
-    else if (ret > 0)
-      /* Time to reap */
-      goto get_cqe;
+    if (hipri) {
+      /* With IORING_SETUP_IOPOLL nothing is ever posted to the CQ unless
+       * somebody polls for it, so epoll on the ring fd would never fire.
+       * Spin in the kernel via io_uring_enter(IORING_ENTER_GETEVENTS). */
+      struct io_uring_cqe *cqe = nullptr;
+      struct __kernel_timespec ts;
+      int ret;
+      if (d->ext_arg) {
+	/* The timeout goes straight to io_uring_enter(), so submitters are
+	 * not involved and can keep going while we wait. */
+	ts.tv_sec = timeout_ms / 1000;
+	ts.tv_nsec = (timeout_ms % 1000) * 1000000;
+	pthread_mutex_lock(&d->cq_mutex);
+	ret = io_uring_wait_cqe_timeout(&d->io_uring, &cqe, &ts);
+	pthread_mutex_unlock(&d->cq_mutex);
+      } else {
+	/* Older kernels: liburing implements the timeout by queueing an
+	 * IORING_OP_TIMEOUT sqe, so the submission side must be held too
+	 * (lock order is sq_mutex, then cq_mutex).  Keep each wait short
+	 * and drop sq_mutex in between so submit_batch() is not shut out
+	 * for the whole poll interval. */
+	ts.tv_sec = 0;
+	ts.tv_nsec = std::min(timeout_ms, 1) * 1000000;
+	pthread_mutex_lock(&d->sq_mutex);
+	pthread_mutex_lock(&d->cq_mutex);
+	ret = io_uring_wait_cqe_timeout(&d->io_uring, &cqe, &ts);
+	pthread_mutex_unlock(&d->cq_mutex);
+	pthread_mutex_unlock(&d->sq_mutex);
+      }
+      if (ret == 0)
+	goto get_cqe;
+      /* -EAGAIN/-EBUSY only mean the CQ or the timeout sqe could not be
+       * posted right now; report no events and let the caller retry. */
+      if (ret != -ETIME && ret != -EINTR &&
+	  ret != -EAGAIN && ret != -EBUSY)
+	events = ret;
+    } else {
+      struct epoll_event ev;
+      int ret = epoll_wait(d->epoll_fd, &ev, 1, timeout_ms);
+      if (ret < 0)
+	events = -errno;
+      else if (ret > 0)
+	/* Time to reap */
+	goto get_cqe;
+    }
   }
 
   return events;
@@ -227,7 +292,7 @@ bool ioring_queue_t::supported()
 
 struct ioring_data {};
 
-ioring_queue_t::ioring_queue_t(unsigned iodepth_)
+ioring_queue_t::ioring_queue_t(unsigned iodepth_, bool hipri_, bool sq_thread_)
 {
   ceph_assert(0);
 }
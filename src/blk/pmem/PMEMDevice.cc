@@ -214,15 +214,18 @@ int PMEMDevice::write(uint64_t off, bufferlist& bl, bool buffered, int write_hin
     return 0;
   }
 
+  // flush each segment as it is copied but fence only once for the whole
+  // write; the data only has to be persistent when we return
   bufferlist::iterator p = bl.begin();
   uint64_t off1 = off;
   while (len) {
     const char *data;
     uint32_t l = p.get_ptr_and_advance(len, &data);
-    pmem_memcpy_persist(addr + off1, data, l);
+    pmem_memcpy_nodrain(addr + off1, data, l);
     len -= l;
     off1 += l;
   }
+  pmem_drain();
   return 0;
 }
 
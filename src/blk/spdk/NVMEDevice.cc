@@ -128,6 +128,8 @@ class SharedDriverQueueData {
   uint32_t block_size;
   uint32_t max_queue_depth;
   struct spdk_nvme_qpair *qpair;
+  uint32_t max_io_completion;
+  uint64_t io_sleep_in_us;
   bool reap_io = false;
   int alloc_buf_from_pool(Task *t, bool write);
 
@@ -152,6 +154,11 @@ class SharedDriverQueueData {
     qpair = spdk_nvme_ctrlr_alloc_io_qpair(ctrlr, &opts, sizeof(opts));
     ceph_assert(qpair != NULL);
 
+    // neither option can change at runtime, so look them up once per qpair
+    // instead of on every submission
+    max_io_completion = (uint32_t)g_conf().get_val<uint64_t>("bluestore_spdk_max_io_completion");
+    io_sleep_in_us = g_conf().get_val<uint64_t>("bluestore_spdk_io_sleep");
+
     // allocate spdk dma memory
     for (uint16_t i = 0; i < data_buffer_default_num; i++) {
       void *b = spdk_dma_zmalloc(data_buffer_size, CEPH_PAGE_SIZE, NULL);
@@ -340,8 +347,6 @@ void SharedDriverQueueData::_aio_handle(Task *t, IOContext *ioc)
 
   int r = 0;
   uint64_t lba_off, lba_count;
-  uint32_t max_io_completion = (uint32_t)g_conf().get_val<uint64_t>("bluestore_spdk_max_io_completion");
-  uint64_t io_sleep_in_us = g_conf().get_val<uint64_t>("bluestore_spdk_io_sleep");
 
   while (ioc->num_running) {
  again:
@@ -3,6 +3,8 @@
  */
 #include <errno.h>
 #include <setjmp.h>
+#include <map>
+#include <mutex>
 #include <string>
 #include <sstream>
 #include <lua.hpp>
@@ -825,6 +827,49 @@ static int unpack_json_command(lua_State *L, struct clslua_hctx *ctx,
   return 0;
 }
 
+/*
+ * Compiled scripts, keyed by their source. Every call carries its script
+ * and runs in a fresh Lua state, so keep the bytecode of recently used
+ * scripts and skip the parser when the same script comes again. Debug
+ * info is kept in the dump so error messages name the chunk as before.
+ */
+#define CLSLUA_MAX_CACHED_SCRIPTS 128
+
+static std::mutex clslua_script_cache_lock;
+static std::map<std::string, std::string> clslua_script_cache;
+
+static int clslua_dump_writer(lua_State *L, const void *p, size_t sz, void *ud)
+{
+  static_cast<std::string*>(ud)->append(static_cast<const char*>(p), sz);
+  return 0;
+}
+
+static int clslua_load_script(lua_State *L, const std::string& script)
+{
+  std::string bytecode;
+  {
+    std::lock_guard l(clslua_script_cache_lock);
+    auto it = clslua_script_cache.find(script);
+    if (it != clslua_script_cache.end())
+      bytecode = it->second;
+  }
+  if (!bytecode.empty())
+    return luaL_loadbufferx(L, bytecode.data(), bytecode.size(),
+                            script.c_str(), "b");
+
+  int ret = luaL_loadstring(L, script.c_str());
+  if (ret)
+    return ret;
+
+  if (lua_dump(L, clslua_dump_writer, &bytecode, 0) == 0) {
+    std::lock_guard l(clslua_script_cache_lock);
+    if (clslua_script_cache.size() >= CLSLUA_MAX_CACHED_SCRIPTS)
+      clslua_script_cache.clear();
+    clslua_script_cache.emplace(script, std::move(bytecode));
+  }
+  return 0;
+}
+
 /*
  * Runs the script, and calls handler.
  */
@@ -875,7 +920,7 @@ static int clslua_eval(lua_State *L)
 
         ctx->script.swap(op.script);
         ctx->handler.swap(op.handler);
-        ctx->input = op.input;
+        ctx->input.swap(op.input);
       }
       break;
 
@@ -898,7 +943,7 @@ static int clslua_eval(lua_State *L)
   lua_settable(L, LUA_REGISTRYINDEX);
 
   /* load and compile chunk */
-  if (luaL_loadstring(L, ctx->script.c_str()))
+  if (clslua_load_script(L, ctx->script))
     return lua_error(L);
 
   /* execute chunk */
@@ -152,12 +152,20 @@ public:
       size_t len,
       ceph::buffer::list::const_iterator& p
       ) {
+      const char *data;
+      size_t l = p.get_ptr_and_advance(len, &data);
+      if (l == len) {
+	// the whole block is contiguous; skip the streaming state
+	return XXH32(data, l, init_value);
+      }
       XXH32_reset(state, init_value);
-      while (len > 0) {
-	const char *data;
-	size_t l = p.get_ptr_and_advance(len, &data);
+      while (true) {
 	XXH32_update(state, data, l);
 	len -= l;
+	if (len == 0) {
+	  break;
+	}
+	l = p.get_ptr_and_advance(len, &data);
       }
       return XXH32_digest(state);
     }
@@ -181,12 +189,20 @@ public:
       size_t len,
       ceph::buffer::list::const_iterator& p
       ) {
+      const char *data;
+      size_t l = p.get_ptr_and_advance(len, &data);
+      if (l == len) {
+	// the whole block is contiguous; skip the streaming state
+	return XXH64(data, l, init_value);
+      }
       XXH64_reset(state, init_value);
-      while (len > 0) {
-	const char *data;
-	size_t l = p.get_ptr_and_advance(len, &data);
+      while (true) {
 	XXH64_update(state, data, l);
 	len -= l;
+	if (len == 0) {
+	  break;
+	}
+	l = p.get_ptr_and_advance(len, &data);
       }
       return XXH64_digest(state);
     }
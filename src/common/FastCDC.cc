@@ -86,12 +86,22 @@ static inline bool _scan(
       *pp = (*p)->c_str();
       *pe = *pp + (*p)->length();
     }
-    const char *te = std::min(*pe, *pp + max - pos);
-    for (; *pp < te; ++(*pp), ++pos) {
-      if ((fp & mask) == mask) {
-	return false;
+    // work on locals: the cursor and fingerprint are reached through
+    // pointers the compiler must assume alias the data being read
+    const char *cp = *pp;
+    const char *te = std::min(*pe, cp + max - pos);
+    uint64_t f = fp;
+    for (; cp < te; ++cp) {
+      if ((f & mask) == mask) {
+	break;
       }
-      fp = (fp << 1) ^ table[*(unsigned char*)*pp];
+      f = (f << 1) ^ table[*(const unsigned char*)cp];
+    }
+    pos += cp - *pp;
+    *pp = cp;
+    fp = f;
+    if (cp < te) {
+      return false;
     }
     if (pos >= max) {
       return true;
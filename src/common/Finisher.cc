@@ -44,6 +44,7 @@ void *Finisher::finisher_thread_entry()
   ldout(cct, 10) << "finisher_thread start" << dendl;
 
   utime_t start;
+  utime_t queued;
   uint64_t count = 0;
   while (!finisher_stop) {
     /// Every time we are woken up, we process the queue until it is empty.
@@ -52,6 +53,7 @@ void *Finisher::finisher_thread_entry()
       // This way other threads can submit new contexts to complete
       // while we are working.
       in_progress_queue.swap(finisher_queue);
+      queued = first_queued;
       finisher_running = true;
       ul.unlock();
       ldout(cct, 10) << "finisher_thread doing " << in_progress_queue << dendl;
@@ -59,6 +61,7 @@ void *Finisher::finisher_thread_entry()
       if (logger) {
 	start = ceph_clock_now();
 	count = in_progress_queue.size();
+	logger->tinc(l_finisher_queue_lat, start - queued);
       }
 
       // Now actually process the contexts.
@@ -28,6 +28,7 @@ enum {
   l_finisher_first = 997082,
   l_finisher_queue_len,
   l_finisher_complete_lat,
+  l_finisher_queue_lat,
   l_finisher_last
 };
 
@@ -54,6 +55,15 @@ class Finisher {
   /// Performance counter for the finisher's queue length.
   /// Only active for named finishers.
   PerfCounters *logger;
+  /// When the oldest context in finisher_queue was queued, if logger is set.
+  utime_t first_queued;
+
+  /// Called with finisher_lock held before adding to finisher_queue.
+  void _note_queued() {
+    if (logger && finisher_queue.empty()) {
+      first_queued = ceph_clock_now();
+    }
+  }
 
   void *finisher_thread_entry();
 
@@ -68,6 +78,7 @@ class Finisher {
   void queue(Context *c, int r = 0) {
     std::unique_lock ul(finisher_lock);
     bool was_empty = finisher_queue.empty();
+    _note_queued();
     finisher_queue.push_back(std::make_pair(c, r));
     if (was_empty) {
       finisher_cond.notify_one();
@@ -82,6 +93,7 @@ class Finisher {
       if (finisher_queue.empty()) {
 	finisher_cond.notify_all();
       }
+      _note_queued();
       for (auto i : ls) {
 	finisher_queue.push_back(std::make_pair(i, 0));
       }
@@ -96,6 +108,7 @@ class Finisher {
       if (finisher_queue.empty()) {
 	finisher_cond.notify_all();
       }
+      _note_queued();
       for (auto i : ls) {
 	finisher_queue.push_back(std::make_pair(i, 0));
       }
@@ -110,6 +123,7 @@ class Finisher {
       if (finisher_queue.empty()) {
 	finisher_cond.notify_all();
       }
+      _note_queued();
       for (auto i : ls) {
 	finisher_queue.push_back(std::make_pair(i, 0));
       }
@@ -153,6 +167,8 @@ class Finisher {
 			  l_finisher_first, l_finisher_last);
     b.add_u64(l_finisher_queue_len, "queue_len");
     b.add_time_avg(l_finisher_complete_lat, "complete_latency");
+    b.add_time_avg(l_finisher_queue_lat, "queue_latency",
+		   "Time the oldest context of each batch waited to be run");
     logger = b.create_perf_counters();
     cct->get_perfcounters_collection()->add(logger);
     logger->set(l_finisher_queue_len, 0);
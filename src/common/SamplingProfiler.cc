@@ -0,0 +1,354 @@
+// -*- mode:C++; tab-width:8; c-basic-offset:2; indent-tabs-mode:t -*-
+// vim: ts=8 sw=2 smarttab
+
+#include "common/SamplingProfiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cxxabi.h>
+#include <signal.h>
+#include <sys/time.h>
+
+#include "acconfig.h"
+#ifdef HAVE_EXECINFO_H
+#include <execinfo.h>
+#endif
+
+#include "common/Formatter.h"
+#include "common/errno.h"
+
+namespace ceph::sampling_profiler {
+
+#if defined(HAVE_EXECINFO_H) && defined(__linux__)
+
+namespace {
+
+constexpr int MAX_FRAMES = 32;
+constexpr uint64_t RING_SIZE = 16384;
+// the handler and the signal trampoline
+constexpr int SKIP_FRAMES = 2;
+// bound the memory used by the aggregated stacks
+constexpr size_t MAX_STACKS = 100000;
+
+struct sample_t {
+  // i + 1 once the slot holds sample i, 0 while it is being written
+  std::atomic<uint64_t> seq{0};
+  int depth = 0;
+  void *pcs[MAX_FRAMES];
+};
+
+// allocated by the first start() and never freed: a SIGPROF that is
+// already pending when stop() disarms the timer may still land here
+sample_t *ring = nullptr;
+std::atomic<uint64_t> head{0};
+
+std::mutex lock;
+bool handler_installed = false;
+bool running = false;
+int cur_hz = 0;
+uint64_t tail = 0;
+uint64_t lost = 0;
+uint64_t total = 0;
+std::map<std::vector<void*>, uint64_t> stacks;
+
+void handle_sigprof(int)
+{
+  int saved_errno = errno;
+  uint64_t i = head.fetch_add(1, std::memory_order_relaxed);
+  sample_t &s = ring[i % RING_SIZE];
+  s.seq.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  s.depth = ::backtrace(s.pcs, MAX_FRAMES);
+  s.seq.store(i + 1, std::memory_order_release);
+  errno = saved_errno;
+}
+
+int set_timer(int hz)
+{
+  struct itimerval it;
+  it.it_interval.tv_sec = 0;
+  it.it_interval.tv_usec = hz ? 1000000 / hz : 0;
+  it.it_value = it.it_interval;
+  return ::setitimer(ITIMER_PROF, &it, nullptr);
+}
+
+// SIGPROF and ITIMER_PROF are process wide, and the gperftools profiler
+// (CPUPROFILE) uses them too.  Leave them alone if somebody else got
+// there first: taking them over would break that profiler for good.
+bool sigprof_in_use(std::ostream& ss)
+{
+  struct sigaction old;
+  if (::sigaction(SIGPROF, nullptr, &old) == 0 &&
+      ((old.sa_flags & SA_SIGINFO) ||
+       (old.sa_handler != SIG_DFL && old.sa_handler != SIG_IGN &&
+	old.sa_handler != handle_sigprof))) {
+    ss << "SIGPROF handler is in use, is another profiler running?";
+    return true;
+  }
+  struct itimerval it;
+  if (!running && ::getitimer(ITIMER_PROF, &it) == 0 &&
+      (it.it_value.tv_sec || it.it_value.tv_usec)) {
+    ss << "ITIMER_PROF is armed, is another profiler running?";
+    return true;
+  }
+  return false;
+}
+
+// move whatever the handler has recorded since the last call into stacks
+void drain()
+{
+  uint64_t h = head.load(std::memory_order_acquire);
+  if (h - tail > RING_SIZE) {
+    lost += h - tail - RING_SIZE;
+    tail = h - RING_SIZE;
+  }
+  std::vector<void*> pcs;
+  for (; tail < h; ++tail) {
+    const sample_t &s = ring[tail % RING_SIZE];
+    if (s.seq.load(std::memory_order_acquire) != tail + 1) {
+      // overwritten, or its handler has not finished yet
+      ++lost;
+      continue;
+    }
+    int depth = std::min(s.depth, MAX_FRAMES);
+    if (depth <= SKIP_FRAMES) {
+      continue;
+    }
+    // root first, as the folded format wants
+    pcs.assign(std::make_reverse_iterator(s.pcs + depth),
+	       std::make_reverse_iterator(s.pcs + SKIP_FRAMES));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (s.seq.load(std::memory_order_relaxed) != tail + 1) {
+      ++lost;
+      continue;
+    }
+    auto p = stacks.find(pcs);
+    if (p != stacks.end()) {
+      ++p->second;
+    } else if (stacks.size() < MAX_STACKS) {
+      stacks.emplace(pcs, 1);
+    } else {
+      ++lost;
+      continue;
+    }
+    ++total;
+  }
+}
+
+// "path/binary(mangled+0x1f) [0x...]" -> demangled name, or the binary
+// name when the symbol is not exported
+std::string symbolize(const char *sym)
+{
+  const char *base = sym, *begin = nullptr, *end = nullptr;
+  for (const char *j = sym; *j; ++j) {
+    if (*j == '/' && !begin)
+      base = j + 1;
+    else if (*j == '(')
+      begin = j + 1;
+    else if (*j == '+')
+      end = j;
+  }
+  if (!begin) {
+    return sym;
+  }
+  if (!end || end <= begin) {
+    return std::string(base, begin - 1);
+  }
+  std::string name(begin, end);
+  if (name.compare(0, 2, "_Z") == 0) {
+    int status;
+    char *d = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+    if (d) {
+      name = d;
+      free(d);
+    }
+  }
+  // ';' separates frames in the folded format
+  for (auto &c : name) {
+    if (c == ';')
+      c = ':';
+  }
+  return name;
+}
+
+} // anonymous namespace
+
+int start(int hz, std::ostream& ss)
+{
+  if (hz <= 0 || hz > MAX_HZ) {
+    ss << "hz must be between 1 and " << MAX_HZ;
+    return -EINVAL;
+  }
+  std::lock_guard l{lock};
+  if (sigprof_in_use(ss)) {
+    return -EBUSY;
+  }
+  if (!ring) {
+    ring = new sample_t[RING_SIZE];
+  }
+  if (!handler_installed) {
+    // the first backtrace() may load libgcc_s, which is not safe from a
+    // signal handler
+    void *warmup[1];
+    ::backtrace(warmup, 1);
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = handle_sigprof;
+    sa.sa_flags = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    if (::sigaction(SIGPROF, &sa, nullptr) < 0) {
+      int r = -errno;
+      ss << "unable to install SIGPROF handler: " << cpp_strerror(r);
+      return r;
+    }
+    handler_installed = true;
+  }
+  if (set_timer(hz) < 0) {
+    int r = -errno;
+    ss << "setitimer failed: " << cpp_strerror(r);
+    return r;
+  }
+  running = true;
+  cur_hz = hz;
+  ss << "sampling at " << hz << " Hz";
+  return 0;
+}
+
+int stop(std::ostream& ss)
+{
+  std::lock_guard l{lock};
+  if (!running) {
+    ss << "not running";
+    return 0;
+  }
+  set_timer(0);
+  // hand SIGPROF back, ignored rather than defaulted: that also discards
+  // a tick that is already pending instead of letting it kill us, and an
+  // ignored signal still counts as free for the gperftools profiler
+  struct sigaction sa;
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = SIG_IGN;
+  sigemptyset(&sa.sa_mask);
+  ::sigaction(SIGPROF, &sa, nullptr);
+  handler_installed = false;
+  running = false;
+  cur_hz = 0;
+  drain();
+  ss << "stopped";
+  return 0;
+}
+
+void reset()
+{
+  std::lock_guard l{lock};
+  if (ring) {
+    tail = head.load(std::memory_order_acquire);
+  }
+  stacks.clear();
+  lost = 0;
+  total = 0;
+}
+
+void dump_status(Formatter *f)
+{
+  std::lock_guard l{lock};
+  if (ring) {
+    drain();
+  }
+  f->open_object_section("profiler");
+  f->dump_bool("running", running);
+  f->dump_int("hz", cur_hz);
+  f->dump_unsigned("samples", total);
+  f->dump_unsigned("lost", lost);
+  f->dump_unsigned("stacks", stacks.size());
+  f->close_section();
+}
+
+void dump_folded(std::ostream& out)
+{
+  std::lock_guard l{lock};
+  if (!ring) {
+    return;
+  }
+  drain();
+  std::map<void*, std::string> names;
+  for (auto& [pcs, count] : stacks) {
+    for (auto pc : pcs) {
+      names.emplace(pc, std::string());
+    }
+  }
+  std::vector<void*> pcs;
+  pcs.reserve(names.size());
+  for (auto& [pc, name] : names) {
+    pcs.push_back(pc);
+  }
+  char **syms = ::backtrace_symbols(pcs.data(), pcs.size());
+  if (syms) {
+    size_t i = 0;
+    for (auto& [pc, name] : names) {
+      name = symbolize(syms[i++]);
+    }
+    free(syms);
+  }
+  // different call sites within the same functions fold into one line
+  std::map<std::string, uint64_t> folded;
+  for (auto& [pcs, count] : stacks) {
+    std::ostringstream line;
+    bool first = true;
+    for (auto pc : pcs) {
+      if (!first)
+	line << ';';
+      first = false;
+      auto& name = names[pc];
+      if (name.empty())
+	line << pc;
+      else
+	line << name;
+    }
+    folded[line.str()] += count;
+  }
+  for (auto& [line, count] : folded) {
+    out << line << ' ' << count << '\n';
+  }
+}
+
+#else
+
+int start(int hz, std::ostream& ss)
+{
+  ss << "sampling profiler is not supported on this platform";
+  return -EOPNOTSUPP;
+}
+
+int stop(std::ostream& ss)
+{
+  ss << "sampling profiler is not supported on this platform";
+  return -EOPNOTSUPP;
+}
+
+void reset()
+{
+}
+
+void dump_status(Formatter *f)
+{
+  f->open_object_section("profiler");
+  f->dump_bool("running", false);
+  f->close_section();
+}
+
+void dump_folded(std::ostream& out)
+{
+}
+
+#endif
+
+}
@@ -0,0 +1,46 @@
+// -*- mode:C++; tab-width:8; c-basic-offset:2; indent-tabs-mode:t -*-
+// vim: ts=8 sw=2 smarttab
+
+#ifndef CEPH_COMMON_SAMPLINGPROFILER_H
+#define CEPH_COMMON_SAMPLINGPROFILER_H
+
+#include <iosfwd>
+
+namespace ceph {
+
+class Formatter;
+
+/**
+ * sampling_profiler
+ *
+ * A process wide, low overhead CPU profiler.  While running, an
+ * ITIMER_PROF timer delivers SIGPROF to whichever thread is burning
+ * CPU, and the handler records the interrupted call stack into a
+ * preallocated ring.  Stacks are symbolized and aggregated only when
+ * the ring is drained, which happens from the admin socket via
+ * dump_folded(); the output is in the "folded" format consumed by
+ * flamegraph.pl.
+ *
+ * SIGPROF is also used by the gperftools profiler.  start() refuses
+ * with -EBUSY while another SIGPROF handler or ITIMER_PROF timer is in
+ * place, and stop() leaves SIGPROF ignored so it can be claimed again.
+ */
+namespace sampling_profiler {
+
+/// highest sampling frequency start() accepts
+static constexpr int MAX_HZ = 1000;
+
+/// start sampling at hz samples per CPU second, keeping earlier samples
+int start(int hz, std::ostream& ss);
+/// stop sampling; aggregated samples are kept until reset()
+int stop(std::ostream& ss);
+/// discard every sample collected so far
+void reset();
+void dump_status(Formatter *f);
+/// drain the ring and write one "frame;frame;... count" line per stack
+void dump_folded(std::ostream& out);
+
+}
+}
+
+#endif
@@ -133,7 +133,10 @@ Context* SafeTimer::add_event_at(SafeTimer::clock_t::time_point when, Context *c
     return nullptr;
   }
   scheduled_map_t::value_type s_val(when, callback);
-  scheduled_map_t::iterator i = schedule.insert(s_val);
+  // timeouts are mostly added with the same delay, and so land after
+  // everything already scheduled; the end() hint makes that insert O(1)
+  // while keeping events with equal deadlines in FIFO order
+  scheduled_map_t::iterator i = schedule.insert(schedule.end(), s_val);
 
   event_lookup_map_t::value_type e_val(callback, i);
   pair < event_lookup_map_t::iterator, bool > rval(events.insert(e_val));
@@ -16,6 +16,7 @@
 #define CEPH_TIMER_H
 
 #include <map>
+#include <unordered_map>
 #include "include/common_fwd.h"
 #include "ceph_time.h"
 #include "ceph_mutex.h"
@@ -39,7 +40,8 @@ class SafeTimer
   using clock_t = ceph::real_clock;
   using scheduled_map_t = std::multimap<clock_t::time_point, Context*>;
   scheduled_map_t schedule;
-  using event_lookup_map_t = std::map<Context*, scheduled_map_t::iterator>;
+  using event_lookup_map_t = std::unordered_map<Context*,
+						scheduled_map_t::iterator>;
   event_lookup_map_t events;
   bool stopping;
 
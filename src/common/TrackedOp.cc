@@ -464,6 +464,23 @@ void TrackedOp::mark_event(std::string_view event, utime_t stamp)
     std::lock_guard l(lock);
     events.emplace_back(stamp, event);
   }
+  _mark_event_done(event, stamp);
+}
+
+void TrackedOp::mark_event_static(const char *event, utime_t stamp)
+{
+  if (!state)
+    return;
+
+  {
+    std::lock_guard l(lock);
+    events.emplace_back(stamp, event, nullptr);
+  }
+  _mark_event_done(event, stamp);
+}
+
+void TrackedOp::_mark_event_done(std::string_view event, utime_t stamp)
+{
   dout(6) << " seq: " << seq
 	  << ", time: " << stamp
 	  << ", event: " << event
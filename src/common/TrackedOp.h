@@ -187,10 +187,10 @@ public:
     typename T::Ref retval(new T(params, this));
     retval->tracking_start();
     if (is_tracking()) {
-      retval->mark_event("throttled", params->get_throttle_stamp());
-      retval->mark_event("header_read", params->get_recv_stamp());
-      retval->mark_event("all_read", params->get_recv_complete_stamp());
-      retval->mark_event("dispatched", params->get_dispatch_stamp());
+      retval->mark_event_static("throttled", params->get_throttle_stamp());
+      retval->mark_event_static("header_read", params->get_recv_stamp());
+      retval->mark_event_static("all_read", params->get_recv_complete_stamp());
+      retval->mark_event_static("dispatched", params->get_dispatch_stamp());
     }
 
     return retval;
@@ -228,21 +228,24 @@ protected:
 
   struct Event {
     utime_t stamp;
-    std::string str;
+    const char *literal = nullptr; ///< set when the name needs no copy
+    std::string str;               ///< the name otherwise
 
     Event(utime_t t, std::string_view s) : stamp(t), str(s) {}
+    Event(utime_t t, const char *lit, std::nullptr_t)
+      : stamp(t), literal(lit) {}
 
-    int compare(const char *s) const {
-      return str.compare(s);
+    std::string_view name() const {
+      return literal ? std::string_view(literal) : std::string_view(str);
     }
 
-    const char *c_str() const {
-      return str.c_str();
+    int compare(const char *s) const {
+      return name().compare(s);
     }
 
     void dump(ceph::Formatter *f) const {
       f->dump_stream("time") << stamp;
-      f->dump_string("event", str);
+      f->dump_string("event", name());
     }
   };
 
@@ -303,7 +306,7 @@ public:
 	break;
 
       case STATE_LIVE:
-	mark_event("done");
+	mark_event_static("done");
 	tracker->unregister_inflight_op(this);
 	_unregistered();
 	if (!tracker->is_tracking()) {
@@ -342,6 +345,7 @@ private:
     desc = desc_str.c_str();
     want_new_desc = false;
   }
+  void _mark_event_done(std::string_view event, utime_t stamp);
 public:
   void reset_desc() {
     want_new_desc = true;
@@ -360,6 +364,9 @@ public:
   }
 
   void mark_event(std::string_view event, utime_t stamp=ceph_clock_now());
+  /// records event by pointer instead of copying it, so it must outlive
+  /// the op: use it for string literals and __func__ only
+  void mark_event_static(const char *event, utime_t stamp=ceph_clock_now());
 
   void mark_nowarn() {
     warn_interval_multiplier = 0;
@@ -367,14 +374,14 @@ public:
 
   virtual std::string_view state_string() const {
     std::lock_guard l(lock);
-    return events.empty() ? std::string_view() : std::string_view(events.rbegin()->str);
+    return events.empty() ? std::string_view() : events.rbegin()->name();
   }
 
   void dump(utime_t now, ceph::Formatter *f) const;
 
   void tracking_start() {
     if (tracker->register_inflight_op(this)) {
-      events.emplace_back(initiated_at, "initiated");
+      events.emplace_back(initiated_at, "initiated", nullptr);
       state = STATE_LIVE;
     }
   }
@@ -43,6 +43,7 @@
 #include "common/config.h"
 #include "common/config_obs.h"
 #include "common/PluginRegistry.h"
+#include "common/SamplingProfiler.h"
 #include "common/valgrind.h"
 #include "include/spinlock.h"
 
@@ -533,6 +534,25 @@ int CephContext::_do_command(
     }
     f->close_section();
   }
+  else if (command == "profiler start") {
+    int64_t hz = 99;
+    cmd_getval(cmdmap, "hz", hz);
+    r = ceph::sampling_profiler::start(hz, ss);
+  }
+  else if (command == "profiler stop") {
+    r = ceph::sampling_profiler::stop(ss);
+  }
+  else if (command == "profiler reset") {
+    ceph::sampling_profiler::reset();
+  }
+  else if (command == "profiler status") {
+    ceph::sampling_profiler::dump_status(f);
+  }
+  else if (command == "profiler dump") {
+    std::ostringstream os;
+    ceph::sampling_profiler::dump_folded(os);
+    out->append(os.str());
+  }
   else {
     std::string section(command);
     boost::replace_all(section, " ", "_");
@@ -705,6 +725,11 @@ CephContext::CephContext(uint32_t module_type_,
   _admin_socket->register_command("perf schema", _admin_hook, "dump perfcounters schema");
   _admin_socket->register_command("perf histogram schema", _admin_hook, "dump perf histogram schema");
   _admin_socket->register_command("perf reset name=var,type=CephString", _admin_hook, "perf reset <name>: perf reset all or one perfcounter name");
+  _admin_socket->register_command("profiler start name=hz,type=CephInt,range=1|1000,req=false", _admin_hook, "start sampling CPU stacks at <hz> (default 99) per CPU second");
+  _admin_socket->register_command("profiler stop", _admin_hook, "stop sampling CPU stacks");
+  _admin_socket->register_command("profiler reset", _admin_hook, "discard sampled CPU stacks");
+  _admin_socket->register_command("profiler status", _admin_hook, "show sampling profiler state");
+  _admin_socket->register_command("profiler dump", _admin_hook, "dump sampled CPU stacks in folded format for flamegraphs");
   _admin_socket->register_command("config show", _admin_hook, "dump current config settings");
   _admin_socket->register_command("config help name=var,type=CephString,req=false", _admin_hook, "get config setting schema and descriptions");
   _admin_socket->register_command("config set name=var,type=CephString name=val,type=CephString,n=N",  _admin_hook, "config set <field> <val> [<val> ...]: set a config variable");
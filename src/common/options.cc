@@ -962,6 +962,18 @@ std::vector<Option> get_global_options() {
     .set_default(4_K)
     .set_description("Maximum amount of data to prefetch out of the socket receive buffer"),
 
+    Option("ms_tcp_zerocopy", Option::TYPE_BOOL, Option::LEVEL_ADVANCED)
+    .set_default(false)
+    .set_description("Send large payloads with MSG_ZEROCOPY on posix sockets")
+    .set_long_description("When enabled, sends of at least ms_tcp_zerocopy_threshold bytes are handed to the kernel with MSG_ZEROCOPY instead of being copied into the socket buffer. The buffers stay referenced until the kernel reports completion on the socket error queue. Only applies to the posix stack on Linux; elsewhere it is ignored.")
+    .add_see_also("ms_tcp_zerocopy_threshold"),
+
+    Option("ms_tcp_zerocopy_threshold", Option::TYPE_SIZE, Option::LEVEL_ADVANCED)
+    .set_default(64_K)
+    .set_description("Minimum send size to use MSG_ZEROCOPY for")
+    .set_long_description("Page pinning and completion handling cost more than a copy for small sends, so only sends at least this large use MSG_ZEROCOPY.")
+    .add_see_also("ms_tcp_zerocopy"),
+
     Option("ms_initial_backoff", Option::TYPE_FLOAT, Option::LEVEL_ADVANCED)
     .set_default(.2)
     .set_description("Initial backoff after a network error is detected (seconds)"),
@@ -1141,6 +1153,17 @@ std::vector<Option> get_global_options() {
     .set_description("Maximum threadpool size of AsyncMessenger")
     .add_see_also("ms_async_op_threads"),
 
+    Option("ms_async_busy_poll_us", Option::TYPE_UINT, Option::LEVEL_ADVANCED)
+    .set_default(0)
+    .set_flag(Option::FLAG_STARTUP)
+    .set_description("Busy-poll for this many microseconds after handling events before blocking")
+    .set_long_description("After a worker thread handles any event it keeps polling its event driver without blocking for this long, so a following event is picked up without an epoll wakeup. This trades CPU for latency; time spent spinning without finding work is reported as msgr_running_busy_poll_time. 0 always blocks when idle."),
+
+    Option("ms_async_send_batch_bytes", Option::TYPE_SIZE, Option::LEVEL_ADVANCED)
+    .set_default(64_K)
+    .set_description("Coalesce queued outgoing frames into one send up to this many bytes")
+    .set_long_description("When more messages are queued on a connection, their frames are appended to the outgoing buffer and sent together once this many bytes are pending or the queue drains, instead of issuing a send per message. 0 sends every message as soon as it is encoded."),
+
     Option("ms_async_rdma_device_name", Option::TYPE_STR, Option::LEVEL_ADVANCED)
     .set_default("")
     .set_description(""),
@@ -2373,6 +2396,11 @@ std::vector<Option> get_global_options() {
     .set_default(false)
     .set_description(""),
 
+    Option("objecter_balance_reads_by_latency", Option::TYPE_BOOL, Option::LEVEL_ADVANCED)
+    .set_default(false)
+    .set_description("Prefer replicas with lower observed read latency for balanced reads")
+    .set_long_description("When a read is sent with the balance_reads flag, pick two random members of the acting set and send the read to the one with the lower moving average of read latency seen by this client, instead of picking a single random member."),
+
     Option("filer_max_purge_ops", Option::TYPE_UINT, Option::LEVEL_ADVANCED)
     .set_default(10)
     .set_description("Max in-flight operations for purging a striped range (e.g., MDS journal)"),
@@ -2544,6 +2572,19 @@ std::vector<Option> get_global_options() {
     .set_default(0)
     .set_description("maximum number of in-flight client requests"),
 
+    Option("osd_client_message_size_cap_autotune", Option::TYPE_BOOL, Option::LEVEL_ADVANCED)
+    .set_default(false)
+    .set_description("adjust the in-flight client byte limit from observed op queue latency")
+    .set_long_description("Once a tick, the OSD compares the average time client ops waited before being dequeued against osd_client_message_size_cap_autotune_target_latency. It lowers the client byte throttle while the target is exceeded and raises it back toward osd_client_message_size_cap while ops wait less than half the target and the throttle is nearly full. The current limit is the 'max' value of the throttle-osd_client_bytes perf counters.")
+    .add_see_also("osd_client_message_size_cap")
+    .add_see_also("osd_client_message_size_cap_autotune_target_latency"),
+
+    Option("osd_client_message_size_cap_autotune_target_latency", Option::TYPE_FLOAT, Option::LEVEL_ADVANCED)
+    .set_default(0.05)
+    .set_min(0.001)
+    .set_description("target time (seconds) for client ops to wait before being dequeued when autotuning the client byte limit")
+    .add_see_also("osd_client_message_size_cap_autotune"),
+
     Option("osd_crush_update_weight_set", Option::TYPE_BOOL, Option::LEVEL_ADVANCED)
     .set_default(true)
     .set_description("update CRUSH weight-set weights when updating weights")
@@ -2948,6 +2989,44 @@ std::vector<Option> get_global_options() {
     .set_description("mclock anticipation timeout in seconds")
     .set_long_description("the amount of time that mclock waits until the unused resource is forfeited"),
 
+    Option("osd_mclock_scheduler_client_idle_age", Option::TYPE_SECS, Option::LEVEL_ADVANCED)
+    .set_default(300)
+    .set_flag(Option::FLAG_STARTUP)
+    .set_description("Seconds without ops after which mclock marks a client idle")
+    .set_long_description("mClockScheduler keeps tagging state for every client (osd op owner) it has seen. An idle client that becomes active again restarts its tags from the current time instead of building up credit.")
+    .add_see_also("osd_mclock_scheduler_client_erase_age")
+    .add_see_also("osd_op_queue"),
+
+    Option("osd_mclock_scheduler_client_erase_age", Option::TYPE_SECS, Option::LEVEL_ADVANCED)
+    .set_default(600)
+    .set_flag(Option::FLAG_STARTUP)
+    .set_description("Seconds without ops after which mclock forgets a client")
+    .set_long_description("Bounds the memory used for per-client scheduling state on OSDs that serve many short-lived clients. Must not be less than osd_mclock_scheduler_client_idle_age.")
+    .add_see_also("osd_mclock_scheduler_client_idle_age")
+    .add_see_also("osd_mclock_scheduler_client_check_time")
+    .add_see_also("osd_op_queue"),
+
+    Option("osd_mclock_scheduler_client_check_time", Option::TYPE_SECS, Option::LEVEL_ADVANCED)
+    .set_default(60)
+    .set_flag(Option::FLAG_STARTUP)
+    .set_description("Interval in seconds between scans for idle and forgotten mclock clients")
+    .add_see_also("osd_mclock_scheduler_client_erase_age")
+    .add_see_also("osd_op_queue"),
+
+    Option("osd_mclock_max_capacity_iops", Option::TYPE_FLOAT, Option::LEVEL_ADVANCED)
+    .set_default(0.0)
+    .set_description("Random small IO capacity of the OSD's device in IOPS")
+    .set_long_description("Together with osd_mclock_max_sequential_bandwidth, this lets mClockScheduler charge each op a cost proportional to its size, so that large ops use up more of a class's reservation and limit than small ones. Both can be measured with 'ceph tell osd.N bench'. 0 disables size based costs and every op costs 1.")
+    .add_see_also("osd_mclock_max_sequential_bandwidth")
+    .add_see_also("osd_op_queue"),
+
+    Option("osd_mclock_max_sequential_bandwidth", Option::TYPE_SIZE, Option::LEVEL_ADVANCED)
+    .set_default(0)
+    .set_description("Sequential bandwidth of the OSD's device in bytes per second")
+    .set_long_description("See osd_mclock_max_capacity_iops. 0 disables size based costs.")
+    .add_see_also("osd_mclock_max_capacity_iops")
+    .add_see_also("osd_op_queue"),
+
     Option("osd_ignore_stale_divergent_priors", Option::TYPE_BOOL, Option::LEVEL_ADVANCED)
     .set_default(false)
     .set_description(""),
@@ -3687,6 +3766,30 @@ std::vector<Option> get_global_options() {
     .set_default(1048576)
     .set_description("The number of keys required to invoke DeleteRange when deleting muliple keys."),
 
+    Option("rocksdb_cf_compact_on_deletion", Option::TYPE_BOOL, Option::LEVEL_ADVANCED)
+    .set_default(false)
+    .set_flag(Option::FLAG_STARTUP)
+    .set_description("Compact SST files that contain many tombstones")
+    .set_long_description("Installs RocksDB's CompactOnDeletionCollector, which marks an SST file for compaction when a sliding window of keys in it holds too many deletions.  This keeps tombstones from PG and object removal from slowing down iteration long after the delete, at the cost of extra compaction work.")
+    .add_see_also({"rocksdb_cf_compact_on_deletion_sliding_window",
+		   "rocksdb_cf_compact_on_deletion_trigger"}),
+
+    Option("rocksdb_cf_compact_on_deletion_sliding_window", Option::TYPE_UINT, Option::LEVEL_ADVANCED)
+    .set_default(32768)
+    .set_flag(Option::FLAG_STARTUP)
+    .set_description("Number of consecutive keys examined for tombstones")
+    .set_long_description("When rocksdb_cf_compact_on_deletion is enabled, each SST file is scanned with a window of this many consecutive keys as it is written.  A smaller window reacts to shorter runs of deletions.")
+    .add_see_also({"rocksdb_cf_compact_on_deletion",
+		   "rocksdb_cf_compact_on_deletion_trigger"}),
+
+    Option("rocksdb_cf_compact_on_deletion_trigger", Option::TYPE_UINT, Option::LEVEL_ADVANCED)
+    .set_default(16384)
+    .set_flag(Option::FLAG_STARTUP)
+    .set_description("Tombstones within the sliding window that mark an SST file for compaction")
+    .set_long_description("When rocksdb_cf_compact_on_deletion is enabled, an SST file is marked for compaction once any window of rocksdb_cf_compact_on_deletion_sliding_window consecutive keys holds at least this many deletions.  Lower values compact more eagerly.")
+    .add_see_also({"rocksdb_cf_compact_on_deletion",
+		   "rocksdb_cf_compact_on_deletion_sliding_window"}),
+
     Option("rocksdb_bloom_bits_per_key", Option::TYPE_UINT, Option::LEVEL_ADVANCED)
     .set_default(20)
     .set_description("Number of bits per key to use for RocksDB's bloom filters.")
@@ -4001,6 +4104,13 @@ std::vector<Option> get_global_options() {
     .set_default(1_M)
     .set_description(""),
 
+    Option("bluefs_read_random_readahead", Option::TYPE_BOOL, Option::LEVEL_ADVANCED)
+    .set_default(false)
+    .set_flag(Option::FLAG_RUNTIME)
+    .set_description("Detect sequential access through the random read interface and read ahead")
+    .set_long_description("When a random read starts exactly where the previous random read of the same file ended, bluefs reads up to 'bluefs_max_prefetch' bytes into the file's prefetch buffer and serves the following reads from it instead of issuing a direct IO per RocksDB block.")
+    .add_see_also("bluefs_max_prefetch"),
+
     Option("bluefs_min_log_runway", Option::TYPE_SIZE, Option::LEVEL_ADVANCED)
     .set_default(1_M)
     .set_description(""),
@@ -4323,6 +4433,13 @@ std::vector<Option> get_global_options() {
     .set_description("Compression ratio required to store compressed data")
     .set_long_description("If we compress data and get less than this we discard the result and store the original uncompressed data."),
 
+    Option("bluestore_compression_sample_size", Option::TYPE_SIZE, Option::LEVEL_ADVANCED)
+    .set_default(0)
+    .set_flag(Option::FLAG_RUNTIME)
+    .set_description("Size of the sample compressed before each blob")
+    .set_long_description("Before compressing a blob at least four times this size, BlueStore compresses this many bytes from its start.  If the sample does not get any smaller the blob is stored uncompressed without compressing the rest of it.  0 disables sampling; 8K is a sensible size to enable it with.")
+    .add_see_also("bluestore_compression_required_ratio"),
+
     Option("bluestore_extent_map_shard_max_size", Option::TYPE_SIZE, Option::LEVEL_DEV)
     .set_default(1200)
     .set_description("Max size (bytes) for a single extent map shard before splitting"),
@@ -4351,6 +4468,12 @@ std::vector<Option> get_global_options() {
     .set_default(64)
     .set_description("Max pinned cache entries we consider before giving up"),
 
+    Option("bluestore_onode_cache_promote_age", Option::TYPE_FLOAT, Option::LEVEL_ADVANCED)
+    .set_default(1.0)
+    .set_flag(Option::FLAG_STARTUP)
+    .set_description("Seconds an onode must stay cached before reuse promotes it to the hot list")
+    .set_long_description("Newly loaded onodes are kept on a cold list that is trimmed first.  They move to the hot list only when used again at least this long after they were loaded, so scans that touch each object once in a short burst (scrub, backfill) do not evict the working set.  0 promotes onodes as soon as they are released, which is plain LRU."),
+
     Option("bluestore_cache_type", Option::TYPE_STR, Option::LEVEL_DEV)
     .set_default("2q")
     .set_enum_allowed({"2q", "lru"})
@@ -4510,6 +4633,13 @@ std::vector<Option> get_global_options() {
       .set_default(2)
       .set_description("Number of additional threads to perform quick-fix (shallow fsck) command"),
 
+    Option("bluestore_fsck_progress_interval", Option::TYPE_FLOAT, Option::LEVEL_ADVANCED)
+      .set_default(30.0)
+      .set_min(0.0)
+      .set_flag(Option::FLAG_RUNTIME)
+      .set_description("Seconds between fsck progress reports while scanning objects")
+      .set_long_description("0 disables progress reporting."),
+
     Option("bluestore_throttle_bytes", Option::TYPE_SIZE, Option::LEVEL_ADVANCED)
     .set_default(64_M)
     .set_flag(Option::FLAG_RUNTIME)
@@ -4703,6 +4833,16 @@ std::vector<Option> get_global_options() {
 			  "When free space is smaller than 'bluestore_avl_alloc_bf_free_pct', best-fit mode is used.")
     .add_see_also("bluestore_avl_alloc_bf_threshold"),
 
+    Option("bluestore_avl_alloc_ff_max_search_count", Option::TYPE_UINT, Option::LEVEL_DEV)
+    .set_default(100)
+    .set_description("Search for this many ranges in first-fit mode before switching over to best-fit mode. 0 to iterate through all ranges for required chunk.")
+    .add_see_also("bluestore_avl_alloc_ff_max_search_bytes"),
+
+    Option("bluestore_avl_alloc_ff_max_search_bytes", Option::TYPE_SIZE, Option::LEVEL_DEV)
+    .set_default(16_M)
+    .set_description("Maximum distance to search in first-fit mode before switching over to best-fit mode. 0 to iterate through all ranges for required chunk.")
+    .add_see_also("bluestore_avl_alloc_ff_max_search_count"),
+
     Option("bluestore_hybrid_alloc_mem_cap", Option::TYPE_UINT, Option::LEVEL_DEV)
     .set_default(64_M)
     .set_description("Maximum RAM hybrid allocator should use before enabling bitmap supplement"),
@@ -4727,6 +4867,20 @@ std::vector<Option> get_global_options() {
     .set_default(false)
     .set_description("Enables Linux io_uring API instead of libaio"),
 
+    Option("bdev_ioring_hipri", Option::TYPE_BOOL, Option::LEVEL_ADVANCED)
+    .set_default(false)
+    .set_flag(Option::FLAG_STARTUP)
+    .set_description("Use polled IO completions with io_uring")
+    .set_long_description("Completions are busy-polled from the device instead of being signalled by interrupts. Requires a block device driver with polling support (e.g. nvme with poll_queues configured).")
+    .add_see_also("bdev_ioring"),
+
+    Option("bdev_ioring_sqthread_poll", Option::TYPE_BOOL, Option::LEVEL_ADVANCED)
+    .set_default(false)
+    .set_flag(Option::FLAG_STARTUP)
+    .set_description("Offload io_uring submission to a kernel polling thread (SQPOLL)")
+    .set_long_description("A kernel thread polls the submission queue, so submitting IO normally does not require a system call.")
+    .add_see_also("bdev_ioring"),
+
     // -----------------------------------------
     // kstore
 
@@ -5431,6 +5585,26 @@ std::vector<Option> get_global_options() {
     .set_default(0)
     .set_description("The maximum number concurrent IO operations, 0 for unlimited"),
 
+    Option("crimson_alien_op_num_threads", Option::TYPE_UINT, Option::LEVEL_ADVANCED)
+    .set_default(1)
+    .set_min(1)
+    .set_flag(Option::FLAG_STARTUP)
+    .set_description("The number of threads AlienStore uses to serve requests")
+    .add_see_also("crimson_alien_thread_cpu_cores"),
+
+    Option("crimson_alien_thread_cpu_cores", Option::TYPE_STR, Option::LEVEL_ADVANCED)
+    .set_default("")
+    .set_flag(Option::FLAG_STARTUP)
+    .set_description("CPU cores on which AlienStore threads will run")
+    .set_long_description("A cpu list such as \"0-3,8\". The cores should not overlap with the ones used by seastar reactors. If empty, the threads are pinned to the last online CPU.")
+    .add_see_also("crimson_alien_op_num_threads"),
+
+    Option("seastore_cache_pinned_capacity", Option::TYPE_SIZE, Option::LEVEL_ADVANCED)
+    .set_default(16_M)
+    .set_flag(Option::FLAG_STARTUP)
+    .set_description("Bytes of clean LBA internal nodes SeaStore keeps cached")
+    .set_long_description("Clean LBA tree internal nodes are held in an LRU list up to this size, so that lookups need not reread the upper levels of the tree from disk. Leaf nodes and data extents are not held."),
+
     // ----------------------------
     // blk specific options
     Option("bdev_type", Option::TYPE_STR, Option::LEVEL_ADVANCED)
@@ -6677,6 +6851,27 @@ std::vector<Option> get_rgw_options() {
     .set_default(120)
     .set_description(""),
 
+    Option("rgw_data_sync_spawn_window", Option::TYPE_INT, Option::LEVEL_ADVANCED)
+    .set_default(20)
+    .set_min(1)
+    .set_description("Maximum number of concurrent bucket syncs per data log shard")
+    .set_long_description(
+        "The number of bucket shards a data sync shard coroutine will sync "
+        "in parallel before waiting for one of them to complete.")
+    .add_see_also("rgw_bucket_sync_spawn_window"),
+
+    Option("rgw_bucket_sync_spawn_window", Option::TYPE_INT, Option::LEVEL_ADVANCED)
+    .set_default(20)
+    .set_min(1)
+    .set_description("Maximum number of concurrent object syncs per bucket shard")
+    .set_long_description(
+        "The number of objects that full and incremental bucket sync will "
+        "fetch in parallel from a single bucket shard, and the number of "
+        "bucket shards synced in parallel for one bucket.  Raising it helps "
+        "when a single hot bucket is limited by the latency of the remote "
+        "zone.")
+    .add_see_also("rgw_data_sync_spawn_window"),
+
     Option("rgw_sync_log_trim_interval", Option::TYPE_INT, Option::LEVEL_ADVANCED)
     .set_default(1200)
     .set_description("Sync log trim interval")
@@ -7790,6 +7985,16 @@ static std::vector<Option> get_immutable_object_cache_options() {
     Option("immutable_object_cache_watermark", Option::TYPE_FLOAT, Option::LEVEL_ADVANCED)
     .set_default(0.1)
     .set_description("immutable object cache water mark"),
+
+    Option("immutable_object_cache_promote_threshold", Option::TYPE_UINT, Option::LEVEL_ADVANCED)
+    .set_default(1)
+    .set_min(1)
+    .set_description("number of misses before an object is promoted")
+    .set_long_description("Promoting an object costs a full read from the "
+                          "cluster and a write to the cache device. Objects "
+                          "that are only read once, e.g. by a scan of a "
+                          "clone, can be kept out of the cache by requiring "
+                          "them to be missed this many times first."),
   });
 }
 
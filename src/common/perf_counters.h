@@ -22,6 +22,7 @@
 #include <memory>
 #include <atomic>
 #include <cstdint>
+#include <pthread.h>
 
 #include "common/perf_histogram.h"
 #include "include/utime.h"
@@ -113,6 +114,18 @@ public:
     prio_default = prio_;
   }
 
+  /**
+   * Store the counters added from now on in per-thread shards, folded
+   * together when read.  This trades memory and read cost for avoiding
+   * cache line contention on counters bumped from many threads.  Only
+   * applies to counters and averages; gauges and histograms are never
+   * sharded.
+   */
+  void set_sharded_default(bool sharded_)
+  {
+    sharded_default = sharded_;
+  }
+
   PerfCounters* create_perf_counters();
 private:
   PerfCountersBuilder(const PerfCountersBuilder &rhs);
@@ -124,6 +137,7 @@ private:
   PerfCounters *m_perf_counters;
 
   int prio_default = 0;
+  bool sharded_default = false;
 };
 
 /*
@@ -154,6 +168,18 @@ private:
 class PerfCounters
 {
 public:
+  enum {
+    num_shard_bits = 4,
+    num_shards = 1 << num_shard_bits
+  };
+
+  // one thread's share of a sharded counter, on its own cache line
+  struct perf_counter_shard_t {
+    std::atomic<uint64_t> u64 = { 0 };
+    std::atomic<uint64_t> avgcount = { 0 };
+    std::atomic<uint64_t> avgcount2 = { 0 };
+  } __attribute__ ((aligned (128)));
+
   /** Represents a PerfCounters data element. */
   struct perf_counter_data_any_d {
     perf_counter_data_any_d()
@@ -189,6 +215,8 @@ public:
     std::atomic<uint64_t> avgcount = { 0 };
     std::atomic<uint64_t> avgcount2 = { 0 };
     std::unique_ptr<PerfHistogram<>> histogram;
+    /// per-thread storage, replaces u64 and the avgcounts if set
+    std::unique_ptr<perf_counter_shard_t[]> shards;
 
     void reset()
     {
@@ -196,22 +224,121 @@ public:
 	    u64 = 0;
 	    avgcount = 0;
 	    avgcount2 = 0;
+	    if (shards) {
+	      for (unsigned i = 0; i < num_shards; i++) {
+	        shards[i].u64 = 0;
+	        shards[i].avgcount = 0;
+	        shards[i].avgcount2 = 0;
+	      }
+	    }
       }
       if (histogram) {
         histogram->reset();
       }
     }
 
+    /// add amt to the value, counting one more sample for averages
+    void add(uint64_t amt) {
+      if (shards) {
+	add(pick_a_shard(), amt);
+      } else {
+	add(u64, avgcount, avgcount2, amt);
+      }
+    }
+
+    /// overwrite the value, counting one more sample for averages
+    void assign(uint64_t amt) {
+      if (!shards) {
+	assign(u64, avgcount, avgcount2, amt);
+	return;
+      }
+      assign(shards[0].u64, shards[0].avgcount, shards[0].avgcount2, amt);
+      for (unsigned i = 1; i < num_shards; i++) {
+	shards[i].u64 = 0;
+      }
+    }
+
+    /// subtract amt from the value of a counter without average
+    void sub(uint64_t amt) {
+      if (shards) {
+	pick_a_shard().u64 -= amt;
+      } else {
+	u64 -= amt;
+      }
+    }
+
+    /// read the value, adding up the shards if sharded
+    uint64_t read_u64() const {
+      if (!shards) {
+	return u64;
+      }
+      uint64_t sum = 0;
+      for (unsigned i = 0; i < num_shards; i++) {
+	sum += shards[i].u64;
+      }
+      return sum;
+    }
+
     // read <sum, count> safely by making sure the post- and pre-count
     // are identical; in other words the whole loop needs to be run
     // without any intervening calls to inc, set, or tinc.
     std::pair<uint64_t,uint64_t> read_avg() const {
-      uint64_t sum, count;
+      if (!shards) {
+	return read_avg(u64, avgcount, avgcount2);
+      }
+      std::pair<uint64_t,uint64_t> total = { 0, 0 };
+      for (unsigned i = 0; i < num_shards; i++) {
+	auto a = read_avg(shards[i].u64, shards[i].avgcount,
+			  shards[i].avgcount2);
+	total.first += a.first;
+	total.second += a.second;
+      }
+      return total;
+    }
+
+  private:
+    perf_counter_shard_t& pick_a_shard() {
+      // see mempool::pool_t::pick_a_shard()
+      size_t me = (size_t)pthread_self();
+      return shards[(me >> 12) & (num_shards - 1)];
+    }
+    void add(perf_counter_shard_t& shard, uint64_t amt) {
+      add(shard.u64, shard.avgcount, shard.avgcount2, amt);
+    }
+    void add(std::atomic<uint64_t>& sum,
+	     std::atomic<uint64_t>& count,
+	     std::atomic<uint64_t>& count2,
+	     uint64_t amt) {
+      if (type & PERFCOUNTER_LONGRUNAVG) {
+	count++;
+	sum += amt;
+	count2++;
+      } else {
+	sum += amt;
+      }
+    }
+    void assign(std::atomic<uint64_t>& sum,
+		std::atomic<uint64_t>& count,
+		std::atomic<uint64_t>& count2,
+		uint64_t amt) {
+      if (type & PERFCOUNTER_LONGRUNAVG) {
+	count++;
+	sum = amt;
+	count2++;
+      } else {
+	sum = amt;
+      }
+    }
+    static std::pair<uint64_t,uint64_t> read_avg(
+      const std::atomic<uint64_t>& sum,
+      const std::atomic<uint64_t>& count,
+      const std::atomic<uint64_t>& count2) {
+      uint64_t s, c;
       do {
-	count = avgcount2;
-	sum = u64;
-      } while (avgcount != count);
-      return { sum, count };
+	c = count2;
+	s = sum;
+      } while (count != c);
+      return { s, c };
     }
   };
 
@@ -17,15 +17,43 @@
 /* Estimate data expansion after decompression */
 static const unsigned int expansion_ratio[] = {5, 20, 50, 100, 200};
 
-QatAccel::~QatAccel() {
-  if (NULL != session.internal) {
-    qzTeardownSession(&session);
-    qzClose(&session);
+void QatAccel::session_deleter::operator()(QzSession_T *session) {
+  if (NULL != session->internal) {
+    qzTeardownSession(session);
+    qzClose(session);
   }
+  delete session;
+}
+
+QatAccel::~QatAccel() = default;
+
+QatAccel::session_ptr QatAccel::get_session() {
+  {
+    std::lock_guard l(mutex);
+    if (!sessions.empty()) {
+      session_ptr session = std::move(sessions.back());
+      sessions.pop_back();
+      return session;
+    }
+  }
+
+  session_ptr session(new QzSession_T());
+  int rc = qzInit(session.get(), QZ_SW_BACKUP_DEFAULT);
+  if (rc != QZ_OK && rc != QZ_DUPLICATE && rc != QZ_NO_HW)
+    return nullptr;
+  rc = qzSetupSession(session.get(), &session_params);
+  if (rc != QZ_OK && rc != QZ_DUPLICATE && rc != QZ_NO_HW)
+    return nullptr;
+  return session;
+}
+
+void QatAccel::put_session(session_ptr session) {
+  std::lock_guard l(mutex);
+  sessions.push_back(std::move(session));
 }
 
 bool QatAccel::init(const std::string &alg) {
-  QzSessionParams_T params = {(QzHuffmanHdr_T)0,};
+  QzSessionParams_T &params = session_params;
   int rc;
 
   rc = qzGetDefaults(&params);
@@ -45,28 +73,28 @@ bool QatAccel::init(const std::string &alg) {
   if (rc != QZ_OK)
       return false;
 
-  rc = qzInit(&session, QZ_SW_BACKUP_DEFAULT);
-  if (rc != QZ_OK && rc != QZ_DUPLICATE && rc != QZ_NO_HW)
-    return false;
-
-  rc = qzSetupSession(&session, &params);
-  if (rc != QZ_OK && rc != QZ_DUPLICATE && rc != QZ_NO_HW ) {
-    qzTeardownSession(&session);
-    qzClose(&session);
+  // set up the first session now so that a missing or broken device is
+  // reported here rather than on the first I/O
+  session_ptr session = get_session();
+  if (!session)
     return false;
-  }
+  put_session(std::move(session));
 
   return true;
 }
 
 int QatAccel::compress(const bufferlist &in, bufferlist &out, boost::optional<int32_t> &compressor_message) {
+  session_guard session(*this);
+  if (!session.get())
+    return -1;
+
   for (auto &i : in.buffers()) {
     const unsigned char* c_in = (unsigned char*) i.c_str();
     unsigned int len = i.length();
     unsigned int out_len = qzMaxCompressedLength(len);
 
     bufferptr ptr = buffer::create_small_page_aligned(out_len);
-    int rc = qzCompress(&session, c_in, &len, (unsigned char *)ptr.c_str(), &out_len, 1);
+    int rc = qzCompress(session.get(), c_in, &len, (unsigned char *)ptr.c_str(), &out_len, 1);
     if (rc != QZ_OK)
       return -1;
     out.append(ptr, 0, out_len);
@@ -84,6 +112,10 @@ int QatAccel::decompress(bufferlist::const_iterator &p,
 		 size_t compressed_len,
 		 bufferlist &dst,
 		 boost::optional<int32_t> compressor_message) {
+  session_guard session(*this);
+  if (!session.get())
+    return -1;
+
   unsigned int ratio_idx = 0;
   bool read_more = false;
   bool joint = false;
@@ -107,9 +139,9 @@ int QatAccel::decompress(bufferlist::const_iterator &p,
     bufferptr ptr = buffer::create_small_page_aligned(out_len);
 
     if (joint)
-      rc = qzDecompress(&session, (const unsigned char*)tmp.c_str(), &len, (unsigned char*)ptr.c_str(), &out_len);
+      rc = qzDecompress(session.get(), (const unsigned char*)tmp.c_str(), &len, (unsigned char*)ptr.c_str(), &out_len);
     else
-      rc = qzDecompress(&session, (const unsigned char*)cur_ptr.c_str(), &len, (unsigned char*)ptr.c_str(), &out_len);
+      rc = qzDecompress(session.get(), (const unsigned char*)cur_ptr.c_str(), &len, (unsigned char*)ptr.c_str(), &out_len);
     if (rc == QZ_DATA_ERROR) {
       if (!joint) {
         tmp.append(cur_ptr.c_str(), cur_ptr.length());
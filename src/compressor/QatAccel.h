@@ -16,13 +16,43 @@
 #define CEPH_QATACCEL_H
 
 #include <qatzip.h>
+#include <memory>
+#include <mutex>
+#include <vector>
 #include "include/buffer.h"
 
 class QatAccel {
-  QzSession_T session;
+  struct session_deleter {
+    void operator()(QzSession_T *session);
+  };
+  using session_ptr = std::unique_ptr<QzSession_T, session_deleter>;
+
+  // a QATzip session must not be used by two threads at once, while one
+  // compressor is shared by every thread of the daemon.  keep a pool of
+  // idle sessions so that concurrent callers each get their own, without
+  // setting one up per call.
+  QzSessionParams_T session_params = {(QzHuffmanHdr_T)0,};
+  std::mutex mutex;
+  std::vector<session_ptr> sessions;
+
+  session_ptr get_session();
+  void put_session(session_ptr session);
+
+  class session_guard {
+    QatAccel &accel;
+    session_ptr session;
+  public:
+    explicit session_guard(QatAccel &accel)
+      : accel(accel), session(accel.get_session()) {}
+    ~session_guard() {
+      if (session)
+        accel.put_session(std::move(session));
+    }
+    QzSession_T *get() { return session.get(); }
+  };
 
  public:
-  QatAccel() : session({0}) {}
+  QatAccel() = default;
   ~QatAccel();
 
   bool init(const std::string &alg);
@@ -15,11 +15,14 @@
 #ifndef CEPH_ZSTDCOMPRESSOR_H
 #define CEPH_ZSTDCOMPRESSOR_H
 
+#include <memory>
+
 #define ZSTD_STATIC_LINKING_ONLY
 #include "zstd/lib/zstd.h"
 
 #include "include/buffer.h"
 #include "include/encoding.h"
+#include "include/scope_guard.h"
 #include "compressor/Compressor.h"
 
 class ZstdCompressor : public Compressor {
@@ -27,7 +30,11 @@ class ZstdCompressor : public Compressor {
   ZstdCompressor(CephContext *cct) : Compressor(COMP_ALG_ZSTD, "zstd"), cct(cct) {}
 
   int compress(const ceph::buffer::list &src, ceph::buffer::list &dst, boost::optional<int32_t> &compressor_message) override {
-    ZSTD_CStream *s = ZSTD_createCStream();
+    ZSTD_CStream *s = get_cstream();
+    if (!s) {
+      return -ENOMEM;
+    }
+    auto trim = make_scope_guard([] { trim_cstream(); });
     ZSTD_initCStream_srcSize(s, cct->_conf->compressor_zstd_level, src.length());
     auto p = src.begin();
     size_t left = src.length();
@@ -53,8 +60,6 @@ class ZstdCompressor : public Compressor {
     }
     ceph_assert(p.end());
 
-    ZSTD_freeCStream(s);
-
     // prefix with decompressed length
     ceph::encode((uint32_t)src.length(), dst);
     dst.append(outptr, 0, outbuf.pos);
@@ -82,7 +87,11 @@ class ZstdCompressor : public Compressor {
     outbuf.dst = dstptr.c_str();
     outbuf.size = dstptr.length();
     outbuf.pos = 0;
-    ZSTD_DStream *s = ZSTD_createDStream();
+    ZSTD_DStream *s = get_dstream();
+    if (!s) {
+      return -ENOMEM;
+    }
+    auto trim = make_scope_guard([] { trim_dstream(); });
     ZSTD_initDStream(s);
     while (compressed_len > 0) {
       if (p.end()) {
@@ -95,13 +104,61 @@ class ZstdCompressor : public Compressor {
       ZSTD_decompressStream(s, &outbuf, &inbuf);
       compressed_len -= inbuf.size;
     }
-    ZSTD_freeDStream(s);
 
     dst.append(dstptr, 0, outbuf.pos);
     return 0;
   }
  private:
   CephContext *const cct;
+
+  struct CStreamDeleter {
+    void operator()(ZSTD_CStream *s) const { ZSTD_freeCStream(s); }
+  };
+  struct DStreamDeleter {
+    void operator()(ZSTD_DStream *s) const { ZSTD_freeDStream(s); }
+  };
+
+  // the init calls above reset a stream completely, so each thread keeps
+  // one of each around instead of allocating and freeing the zstd
+  // workspace for every buffer.  a stream only grows, though, so one that
+  // a high level or a large buffer blew up is freed after use rather than
+  // pinned by an otherwise idle thread.
+  static constexpr size_t MAX_CACHED_STREAM_SIZE = 4 << 20;
+
+  static std::unique_ptr<ZSTD_CStream, CStreamDeleter>& cstream() {
+    thread_local std::unique_ptr<ZSTD_CStream, CStreamDeleter> s;
+    return s;
+  }
+  static std::unique_ptr<ZSTD_DStream, DStreamDeleter>& dstream() {
+    thread_local std::unique_ptr<ZSTD_DStream, DStreamDeleter> s;
+    return s;
+  }
+  static ZSTD_CStream *get_cstream() {
+    auto& s = cstream();
+    if (!s) {
+      s.reset(ZSTD_createCStream());
+    }
+    return s.get();
+  }
+  static ZSTD_DStream *get_dstream() {
+    auto& s = dstream();
+    if (!s) {
+      s.reset(ZSTD_createDStream());
+    }
+    return s.get();
+  }
+  static void trim_cstream() {
+    auto& s = cstream();
+    if (s && ZSTD_sizeof_CStream(s.get()) > MAX_CACHED_STREAM_SIZE) {
+      s.reset();
+    }
+  }
+  static void trim_dstream() {
+    auto& s = dstream();
+    if (s && ZSTD_sizeof_DStream(s.get()) > MAX_CACHED_STREAM_SIZE) {
+      s.reset();
+    }
+  }
 };
 
 #endif
@@ -18,6 +18,7 @@
 #include <seastar/core/resource.hh>
 
 #include "common/ceph_context.h"
+#include "common/numa.h"
 #include "global/global_context.h"
 #include "include/Context.h"
 #include "os/bluestore/BlueStore.h"
@@ -67,14 +68,31 @@ AlienStore::AlienStore(const std::string& path, const ConfigValues& values)
   cct->_conf.set_config_values(values);
   store = std::make_unique<BlueStore>(cct.get(), path);
 
-  long cpu_id = 0;
-  if (long nr_cpus = sysconf(_SC_NPROCESSORS_ONLN); nr_cpus != -1) {
-    cpu_id = nr_cpus - 1;
-  } else {
-    logger().error("{}: unable to get nproc: {}", __func__, errno);
-    cpu_id = -1;
+  std::vector<uint64_t> cpu_cores;
+  if (auto cores = cct->_conf.get_val<std::string>("crimson_alien_thread_cpu_cores");
+      !cores.empty()) {
+    cpu_set_t cpu_set;
+    size_t cpu_set_size;
+    if (int r = parse_cpu_set_list(cores.c_str(), &cpu_set_size, &cpu_set);
+        r < 0) {
+      logger().error("{}: unable to parse crimson_alien_thread_cpu_cores '{}': {}",
+                     __func__, cores, r);
+    } else {
+      for (auto cpu : cpu_set_to_set(cpu_set_size, &cpu_set)) {
+        cpu_cores.push_back(cpu);
+      }
+    }
+  }
+  if (cpu_cores.empty()) {
+    if (long nr_cpus = sysconf(_SC_NPROCESSORS_ONLN); nr_cpus != -1) {
+      cpu_cores.push_back(nr_cpus - 1);
+    } else {
+      logger().error("{}: unable to get nproc: {}", __func__, errno);
+    }
   }
-  tp = std::make_unique<crimson::os::ThreadPool>(1, 128, cpu_id);
+  const auto num_threads =
+    cct->_conf.get_val<uint64_t>("crimson_alien_op_num_threads");
+  tp = std::make_unique<crimson::os::ThreadPool>(num_threads, 128, cpu_cores);
 }
 
 seastar::future<> AlienStore::start()
@@ -6,6 +6,7 @@
 #include <condition_variable>
 #include <tuple>
 #include <type_traits>
+#include <vector>
 #include <boost/lockfree/queue.hpp>
 #include <boost/optional.hpp>
 #include <seastar/core/future.hh>
@@ -85,7 +86,7 @@ class ThreadPool {
   bool is_stopping() const {
     return stopping.load(std::memory_order_relaxed);
   }
-  static void pin(unsigned cpu_id);
+  static void pin(const std::vector<uint64_t>& cpus);
   seastar::semaphore& local_free_slots() {
     return submit_queue.local().free_slots;
   }
@@ -97,11 +98,12 @@ public:
    *                 it waits in this queue. we will round this number to
    *                 multiple of the number of cores.
    * @param n_threads the number of threads in this thread pool.
-   * @param cpu the CPU core to which this thread pool is assigned
+   * @param cpus the CPU cores to which this thread pool is assigned, the
+   *             threads are not pinned if it is empty
    * @note each @c Task has its own crimson::thread::Condition, which possesses
    * an fd, so we should keep the size of queue under a reasonable limit.
    */
-  ThreadPool(size_t n_threads, size_t queue_sz, long cpu);
+  ThreadPool(size_t n_threads, size_t queue_sz, const std::vector<uint64_t>& cpus);
   ~ThreadPool();
   seastar::future<> start();
   seastar::future<> stop();
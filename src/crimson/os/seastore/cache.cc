@@ -17,11 +17,15 @@ namespace {
 
 namespace crimson::os::seastore {
 
-Cache::Cache(SegmentManager &segment_manager) :
-  segment_manager(segment_manager) {}
+Cache::Cache(SegmentManager &segment_manager, size_t pinned_capacity) :
+  segment_manager(segment_manager),
+  pinned_capacity(pinned_capacity) {}
 
 Cache::~Cache()
 {
+  while (!pinned.empty()) {
+    unpin_extent(pinned.front());
+  }
   for (auto &i: extents) {
     logger().error("~Cache: extent {} still alive", i);
   }
@@ -37,10 +41,43 @@ void Cache::add_extent(CachedExtentRef ref)
   if (ref->is_dirty()) {
     intrusive_ptr_add_ref(&*ref);
     dirty.push_back(*ref);
+  } else if (should_pin(*ref)) {
+    pin_extent(*ref);
   }
   logger().debug("add_extent: {}", *ref);
 }
 
+void Cache::pin_extent(CachedExtent &ref)
+{
+  assert(ref.is_clean());
+  ceph_assert(!ref.primary_ref_list_hook.is_linked());
+  intrusive_ptr_add_ref(&ref);
+  pinned.push_back(ref);
+  pinned_bytes += ref.get_length();
+  while (pinned_bytes > pinned_capacity && pinned.size() > 1) {
+    unpin_extent(pinned.front());
+  }
+}
+
+void Cache::unpin_extent(CachedExtent &ref)
+{
+  if (ref.is_dirty() || !ref.primary_ref_list_hook.is_linked()) {
+    return;
+  }
+  pinned.erase(pinned.s_iterator_to(ref));
+  pinned_bytes -= ref.get_length();
+  intrusive_ptr_release(&ref);
+}
+
+void Cache::touch_extent(CachedExtent &ref)
+{
+  if (ref.is_dirty() || !ref.primary_ref_list_hook.is_linked()) {
+    return;
+  }
+  pinned.erase(pinned.s_iterator_to(ref));
+  pinned.push_back(ref);
+}
+
 void Cache::mark_dirty(CachedExtentRef ref)
 {
   if (ref->is_dirty()) {
@@ -49,6 +86,7 @@ void Cache::mark_dirty(CachedExtentRef ref)
   }
 
   assert(ref->is_valid());
+  unpin_extent(*ref);
   assert(!ref->primary_ref_list_hook.is_linked());
   intrusive_ptr_add_ref(&*ref);
   dirty.push_back(*ref);
@@ -68,6 +106,7 @@ void Cache::retire_extent(CachedExtentRef ref)
     dirty.erase(dirty.s_iterator_to(*ref));
     intrusive_ptr_release(&*ref);
   } else {
+    unpin_extent(*ref);
     ceph_assert(!ref->primary_ref_list_hook.is_linked());
   }
 }
@@ -218,6 +257,9 @@ Cache::close_ertr::future<> Cache::close()
     dirty.erase(i++);
     intrusive_ptr_release(ptr);
   }
+  while (!pinned.empty()) {
+    unpin_extent(pinned.front());
+  }
   return close_ertr::now();
 }
 
@@ -142,7 +142,11 @@ using TransactionRef = std::unique_ptr<Transaction>;
  */
 class Cache {
 public:
-  Cache(SegmentManager &segment_manager);
+  /// default byte budget for clean LBA internal nodes held in pinned
+  static constexpr size_t DEFAULT_PINNED_CAPACITY = 16 << 20;
+
+  Cache(SegmentManager &segment_manager,
+	size_t pinned_capacity = DEFAULT_PINNED_CAPACITY);
   ~Cache();
 
   TransactionRef get_transaction() {
@@ -180,6 +184,7 @@ public:
   ) {
     if (auto iter = extents.find_offset(offset);
 	       iter != extents.end()) {
+      touch_extent(*iter);
       auto ret = TCachedExtentRef<T>(static_cast<T*>(&*iter));
       return ret->wait_io().then([ret=std::move(ret)]() mutable {
 	return get_extent_ertr::make_ready_future<TCachedExtentRef<T>>(
@@ -361,6 +366,20 @@ public:
   using replay_delta_ret = replay_delta_ertr::future<>;
   replay_delta_ret replay_delta(paddr_t record_base, const delta_info_t &delta);
 
+  /**
+   * test_query_cache
+   *
+   * Returns ref to the extent at offset if it is in the cache, without
+   * reading it or touching its lru position.  For tests.
+   */
+  CachedExtentRef test_query_cache(paddr_t offset) {
+    if (auto iter = extents.find_offset(offset);
+	iter != extents.end()) {
+      return CachedExtentRef(&*iter);
+    }
+    return CachedExtentRef();
+  }
+
   /**
    * print
    *
@@ -377,10 +396,37 @@ private:
   ExtentIndex extents;             ///< set of live extents
   CachedExtent::list dirty;        ///< holds refs to dirty extents
 
+  /**
+   * pinned
+   *
+   * Holds refs to clean LBA internal nodes in lru order (least recently
+   * used first) so that lookups need not reread the upper levels of the
+   * tree once the last transaction referencing them goes away.  Shares
+   * primary_ref_list_hook with dirty, an extent is on at most one of them.
+   */
+  CachedExtent::list pinned;
+  size_t pinned_bytes = 0;
+  const size_t pinned_capacity;
+
+  /// true if ref should be held in pinned while clean
+  static bool should_pin(const CachedExtent &ref) {
+    return ref.get_type() == extent_types_t::LADDR_INTERNAL;
+  }
+
+  /// Take a ref to clean extent ref in pinned, trimming to capacity
+  void pin_extent(CachedExtent &ref);
+
+  /// Drop pinned ref to ref, if any
+  void unpin_extent(CachedExtent &ref);
+
+  /// Move ref to the tail of pinned, if pinned
+  void touch_extent(CachedExtent &ref);
+
   /// alloc buffer for cached extent
   bufferptr alloc_cache_buf(size_t size) {
     // TODO: memory pooling etc
-    auto bp = ceph::bufferptr(size);
+    // page aligned so segment managers can DMA straight into it
+    auto bp = ceph::bufferptr(ceph::buffer::create_page_aligned(size));
     bp.zero();
     return bp;
   }
@@ -2,6 +2,7 @@
 // vim: ts=8 sw=2 smarttab
 
 #include <boost/iterator/counting_iterator.hpp>
+#include <seastar/core/future-util.hh>
 
 #include "crimson/os/seastore/journal.h"
 
@@ -85,12 +86,58 @@ Journal::write_record_ertr::future<> Journal::write_record(
   ceph::bufferlist to_write = encode_record(
     rsize, std::move(record));
   auto target = written_to;
-  written_to += p2roundup(to_write.length(), (unsigned)block_size);
+  auto padded = p2roundup(to_write.length(), (unsigned)block_size);
+  if (padded > to_write.length()) {
+    to_write.append_zero(padded - to_write.length());
+  }
+  written_to += padded;
   logger().debug(
     "write_record, mdlength {}, dlength {}",
     rsize.mdlength,
     rsize.dlength);
-  return current_journal_segment->write(target, to_write).handle_error(
+
+  bool first = !write_batch;
+  if (first) {
+    write_batch = std::make_unique<write_batch_t>();
+    write_batch->segment = current_journal_segment;
+    write_batch->start = target;
+    ++write_batch_seq;
+  }
+  ceph_assert(write_batch->segment == current_journal_segment);
+  ceph_assert(target ==
+	      write_batch->start + (segment_off_t)write_batch->bl.length());
+  write_batch->bl.claim_append(to_write);
+  auto written = write_batch->written.get_shared_future();
+  if (!first) {
+    return write_record_ertr::future<>(std::move(written));
+  }
+  // let the records submitted by the rest of this task join the batch
+  return seastar::later().then([this, seq=write_batch_seq] {
+    if (write_batch && write_batch_seq == seq) {
+      return submit_write_batch();
+    } else {
+      return write_record_ertr::now();
+    }
+  }).safe_then([written=std::move(written)]() mutable {
+    return write_record_ertr::future<>(std::move(written));
+  });
+}
+
+Journal::write_record_ertr::future<> Journal::submit_write_batch()
+{
+  if (!write_batch) {
+    return write_record_ertr::now();
+  }
+  auto batch = std::move(write_batch);
+  auto &segment = *batch->segment;
+  logger().debug(
+    "submit_write_batch, start {}, length {}",
+    batch->start,
+    batch->bl.length());
+  return segment.write(batch->start, std::move(batch->bl)).safe_then(
+    [batch=std::move(batch)] {
+      batch->written.set_value();
+    },
     write_record_ertr::pass_further{},
     crimson::ct_error::assert_all{ "TODO" });
 }
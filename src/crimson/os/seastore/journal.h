@@ -8,6 +8,7 @@
 #include <boost/intrusive_ptr.hpp>
 
 #include <seastar/core/future.hh>
+#include <seastar/core/shared_future.hh>
 
 #include "include/ceph_assert.h"
 #include "include/buffer.h"
@@ -141,7 +142,9 @@ public:
       return crimson::ct_error::erange::make();
     }
     auto roll = needs_roll(total)
-      ? roll_journal_segment()
+      ? submit_write_batch().safe_then([this] {
+	  return roll_journal_segment();
+	})
       : roll_journal_segment_ertr::now();
     return roll.safe_then(
       [this, rsize, record=std::move(record)]() mutable {
@@ -182,6 +185,22 @@ private:
   segment_id_t next_journal_segment_seq = NULL_SEG_ID;
   journal_seq_t current_journal_seq = 0;
 
+  /**
+   * write_batch_t
+   *
+   * Records encoded within the same reactor task are appended here and
+   * written to the segment with a single device write.  Each record
+   * keeps its own header, so the on-disk layout is unchanged.
+   */
+  struct write_batch_t {
+    SegmentRef segment;
+    segment_off_t start = 0;
+    ceph::bufferlist bl;
+    seastar::shared_promise<> written;
+  };
+  std::unique_ptr<write_batch_t> write_batch;
+  uint64_t write_batch_seq = 0;
+
   /// prepare segment for writes, writes out segment header
   using initialize_segment_ertr = crimson::errorator<
     crimson::ct_error::input_output_error>;
@@ -217,6 +236,9 @@ private:
     record_size_t rsize,
     record_t &&record);
 
+  /// write out the pending batch, if any, resolves once it is durable
+  write_record_ertr::future<> submit_write_batch();
+
   /// close current segment and initialize next one
   using roll_journal_segment_ertr = crimson::errorator<
     crimson::ct_error::input_output_error>;
@@ -39,7 +39,10 @@ struct SeastoreCollection final : public FuturizedCollection {
 SeaStore::SeaStore(const std::string& path)
   : segment_manager(segment_manager::create_ephemeral(
 		      segment_manager::DEFAULT_TEST_EPHEMERAL)),
-    cache(std::make_unique<Cache>(*segment_manager)),
+    cache(std::make_unique<Cache>(
+	    *segment_manager,
+	    local_conf().get_val<Option::size_t>(
+	      "seastore_cache_pinned_capacity"))),
     journal(new Journal(*segment_manager)),
     lba_manager(
       lba_manager::create_lba_manager(*segment_manager, *cache)),
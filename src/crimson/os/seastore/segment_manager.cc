@@ -4,6 +4,7 @@
 #include <iostream>
 
 #include "crimson/os/seastore/segment_manager/ephemeral.h"
+#include "crimson/os/seastore/segment_manager/block.h"
 
 namespace crimson::os::seastore::segment_manager {
 
@@ -11,6 +12,10 @@ SegmentManagerRef create_ephemeral(ephemeral_config_t config) {
   return SegmentManagerRef{new EphemeralSegmentManager(config)};
 }
 
+SegmentManagerRef create_block(const std::string &path) {
+  return SegmentManagerRef{new block::BlockSegmentManager(path)};
+}
+
 std::ostream &operator<<(std::ostream &lhs, const ephemeral_config_t &c) {
   return lhs << "ephemeral_config_t(size=" << c.size << ", block_size=" << c.block_size
 	     << ", segment_size=" << c.segment_size << ")";
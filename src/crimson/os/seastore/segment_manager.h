@@ -74,6 +74,7 @@ constexpr size_t PADDR_SIZE = sizeof(paddr_t);
 class SegmentManager {
 public:
   using init_ertr = crimson::errorator<
+    crimson::ct_error::input_output_error,
     crimson::ct_error::enospc,
     crimson::ct_error::invarg,
     crimson::ct_error::erange>;
@@ -103,7 +104,8 @@ public:
   read_ertr::future<ceph::bufferptr> read(
     paddr_t addr,
     size_t len) {
-    auto ptrref = std::make_unique<ceph::bufferptr>(len);
+    auto ptrref = std::make_unique<ceph::bufferptr>(
+      ceph::buffer::create_page_aligned(len));
     return read(addr, len, *ptrref).safe_then(
       [ptrref=std::move(ptrref)]() mutable {
 	return read_ertr::make_ready_future<bufferptr>(std::move(*ptrref));
@@ -140,6 +142,10 @@ constexpr ephemeral_config_t DEFAULT_TEST_EPHEMERAL = {
 std::ostream &operator<<(std::ostream &, const ephemeral_config_t &);
 SegmentManagerRef create_ephemeral(ephemeral_config_t config);
 
+/// SegmentManager on a block device or file prepared by
+/// block::BlockSegmentManager::mkfs()
+SegmentManagerRef create_block(const std::string &path);
+
 }
 
 }
@@ -0,0 +1,394 @@
+// -*- mode:C++; tab-width:8; c-basic-offset:2; indent-tabs-mode:t -*-
+// vim: ts=8 sw=2 smarttab
+
+#include "crimson/common/log.h"
+
+#include "include/buffer.h"
+#include "include/intarith.h"
+#include "crimson/os/seastore/segment_manager/block.h"
+
+namespace {
+  seastar::logger& logger() {
+    return crimson::get_logger(ceph_subsys_filestore);
+  }
+}
+
+namespace crimson::os::seastore::segment_manager::block {
+
+static write_ertr::future<> do_write(
+  seastar::file &device,
+  uint64_t offset,
+  bufferptr &bptr)
+{
+  logger().debug(
+    "block: do_write offset {} len {}",
+    offset,
+    bptr.length());
+  return device.dma_write(
+    offset,
+    bptr.c_str(),
+    bptr.length()
+  ).handle_exception([](auto e) -> write_ertr::future<size_t> {
+    logger().error("do_write: dma_write got error {}", e);
+    return crimson::ct_error::input_output_error::make();
+  }).then([length=bptr.length()](auto result)
+	  -> write_ertr::future<> {
+    if (result != length) {
+      return crimson::ct_error::input_output_error::make();
+    }
+    return write_ertr::now();
+  });
+}
+
+static read_ertr::future<> do_read(
+  seastar::file &device,
+  uint64_t offset,
+  bufferptr &bptr)
+{
+  logger().debug(
+    "block: do_read offset {} len {}",
+    offset,
+    bptr.length());
+  return device.dma_read(
+    offset,
+    bptr.c_str(),
+    bptr.length()
+  ).handle_exception([](auto e) -> read_ertr::future<size_t> {
+    logger().error("do_read: dma_read got error {}", e);
+    return crimson::ct_error::input_output_error::make();
+  }).then([length=bptr.length()](auto result) -> read_ertr::future<> {
+    if (result != length) {
+      return crimson::ct_error::input_output_error::make();
+    }
+    return read_ertr::now();
+  });
+}
+
+/// copy bl into a zeroed, page aligned buffer padded to block_size
+static bufferptr make_aligned_write_buffer(
+  ceph::bufferlist &bl,
+  size_t block_size)
+{
+  auto bp = ceph::buffer::create_page_aligned(
+    p2roundup<size_t>(bl.length(), block_size));
+  bp.zero();
+  bl.begin().copy(bl.length(), bp.c_str());
+  return bp;
+}
+
+SegmentStateTracker::SegmentStateTracker(size_t segments, size_t block_size)
+  : segments(segments),
+    block_size(block_size),
+    bptr(ceph::buffer::create_page_aligned(
+	   get_raw_size(segments, block_size)))
+{
+  bptr.zero();
+}
+
+write_ertr::future<> SegmentStateTracker::write_out(
+  seastar::file &device,
+  uint64_t tracker_offset)
+{
+  return do_write(device, tracker_offset, bptr);
+}
+
+write_ertr::future<> SegmentStateTracker::write_out_segment(
+  seastar::file &device,
+  uint64_t tracker_offset,
+  segment_id_t id)
+{
+  size_t off = p2align<size_t>(id, block_size);
+  return seastar::do_with(
+    bufferptr(bptr, off, block_size),
+    [&device, tracker_offset, off](auto &bp) {
+      return do_write(device, tracker_offset + off, bp);
+    });
+}
+
+read_ertr::future<> SegmentStateTracker::read_in(
+  seastar::file &device,
+  uint64_t tracker_offset)
+{
+  return do_read(device, tracker_offset, bptr);
+}
+
+BlockSegment::BlockSegment(
+  BlockSegmentManager &manager, segment_id_t id)
+  : manager(manager), id(id) {}
+
+segment_off_t BlockSegment::get_write_capacity() const
+{
+  return manager.get_segment_size();
+}
+
+Segment::close_ertr::future<> BlockSegment::close()
+{
+  return manager.segment_close(id);
+}
+
+Segment::write_ertr::future<> BlockSegment::write(
+  segment_off_t offset, ceph::bufferlist bl)
+{
+  if (offset < write_pointer || offset % manager.get_block_size() != 0)
+    return crimson::ct_error::invarg::make();
+
+  if (offset + bl.length() > (size_t)manager.get_segment_size())
+    return crimson::ct_error::enospc::make();
+
+  write_pointer = offset + p2roundup<size_t>(
+    bl.length(), manager.get_block_size());
+  return manager.segment_write({id, offset}, std::move(bl));
+}
+
+BlockSegmentManager::~BlockSegmentManager()
+{
+}
+
+Segment::close_ertr::future<> BlockSegmentManager::segment_close(
+  segment_id_t id)
+{
+  if (tracker->get(id) != segment_state_t::OPEN)
+    return crimson::ct_error::invarg::make();
+
+  tracker->set(id, segment_state_t::CLOSED);
+  return tracker->write_out_segment(
+    device, superblock.tracker_offset, id
+  ).safe_then([this] {
+    return device.flush().handle_exception([](auto e)
+      -> Segment::close_ertr::future<> {
+      logger().error("segment_close: flush got error {}", e);
+      return crimson::ct_error::input_output_error::make();
+    });
+  });
+}
+
+Segment::write_ertr::future<> BlockSegmentManager::segment_write(
+  paddr_t addr,
+  ceph::bufferlist bl)
+{
+  logger().debug(
+    "segment_write to segment {} at offset {}, physical offset {}, len {}",
+    addr.segment,
+    addr.offset,
+    get_offset(addr),
+    bl.length());
+  if (tracker->get(addr.segment) != segment_state_t::OPEN)
+    return crimson::ct_error::ebadf::make();
+
+  return seastar::do_with(
+    make_aligned_write_buffer(bl, superblock.block_size),
+    [this, addr](auto &bp) {
+      return do_write(device, get_offset(addr), bp);
+    });
+}
+
+BlockSegmentManager::mkfs_ertr::future<> BlockSegmentManager::mkfs(
+  const std::string &path,
+  size_t segment_size)
+{
+  logger().debug("mkfs: path {} segment_size {}", path, segment_size);
+  return seastar::open_file_dma(
+    path, seastar::open_flags::rw
+  ).handle_exception([path](auto e) -> mkfs_ertr::future<seastar::file> {
+    logger().error("mkfs: unable to open {}: {}", path, e);
+    return crimson::ct_error::input_output_error::make();
+  }).safe_then([segment_size](auto file) {
+    return seastar::do_with(
+      std::move(file),
+      block_sm_superblock_t{},
+      std::unique_ptr<SegmentStateTracker>(),
+      [segment_size](auto &device, auto &sb, auto &tracker) {
+	return device.size().then([&, segment_size](uint64_t size)
+	  -> mkfs_ertr::future<> {
+	  sb.block_size = std::max<size_t>(
+	    4 << 10, device.disk_write_dma_alignment());
+	  if (segment_size == 0 || segment_size % sb.block_size != 0) {
+	    return crimson::ct_error::invarg::make();
+	  }
+	  sb.size = size;
+	  sb.segment_size = segment_size;
+	  sb.tracker_offset = sb.block_size;
+	  size_t max_segments = size / segment_size;
+	  sb.first_segment_offset = sb.tracker_offset +
+	    SegmentStateTracker::get_raw_size(max_segments, sb.block_size);
+	  if (sb.first_segment_offset >= size) {
+	    return crimson::ct_error::invarg::make();
+	  }
+	  sb.segments = (size - sb.first_segment_offset) / segment_size;
+	  if (sb.segments == 0) {
+	    return crimson::ct_error::invarg::make();
+	  }
+	  logger().debug(
+	    "mkfs: size {} block_size {} segments {} first_segment_offset {}",
+	    sb.size, sb.block_size, sb.segments, sb.first_segment_offset);
+
+	  tracker = std::make_unique<SegmentStateTracker>(
+	    sb.segments, sb.block_size);
+	  return tracker->write_out(device, sb.tracker_offset
+	  ).safe_then([&] {
+	    bufferlist bl;
+	    encode(sb, bl);
+	    return seastar::do_with(
+	      make_aligned_write_buffer(bl, sb.block_size),
+	      [&device](auto &bp) {
+		return do_write(device, 0, bp);
+	      });
+	  }).safe_then([&device] {
+	    return device.flush().handle_exception([](auto e)
+	      -> write_ertr::future<> {
+	      logger().error("mkfs: flush got error {}", e);
+	      return crimson::ct_error::input_output_error::make();
+	    });
+	  });
+	}).finally([&device] {
+	  return device.close();
+	});
+      });
+  });
+}
+
+SegmentManager::init_ertr::future<> BlockSegmentManager::init()
+{
+  logger().debug("init: opening {}", device_path);
+  return seastar::open_file_dma(
+    device_path, seastar::open_flags::rw
+  ).handle_exception([this](auto e) -> init_ertr::future<seastar::file> {
+    logger().error("init: unable to open {}: {}", device_path, e);
+    return crimson::ct_error::input_output_error::make();
+  }).safe_then([this](auto file) {
+    device = std::move(file);
+    auto block_size = std::max<size_t>(
+      4 << 10, device.disk_read_dma_alignment());
+    return seastar::do_with(
+      bufferptr(ceph::buffer::create_page_aligned(block_size)),
+      [this](auto &bp) {
+	return do_read(device, 0, bp).safe_then([this, &bp]()
+	  -> init_ertr::future<> {
+	  bufferlist bl;
+	  bl.push_back(bp);
+	  auto p = bl.cbegin();
+	  try {
+	    decode(superblock, p);
+	  } catch (ceph::buffer::error &e) {
+	    logger().error("init: unable to decode superblock");
+	    return crimson::ct_error::invarg::make();
+	  }
+	  if (superblock.block_size == 0 ||
+	      superblock.segment_size % superblock.block_size != 0 ||
+	      superblock.segments == 0) {
+	    logger().error("init: bad superblock");
+	    return crimson::ct_error::invarg::make();
+	  }
+	  tracker = std::make_unique<SegmentStateTracker>(
+	    superblock.segments, superblock.block_size);
+	  return tracker->read_in(device, superblock.tracker_offset);
+	});
+      });
+  }).safe_then([this] {
+    // a segment left open by a crash may hold a partial journal tail;
+    // it is no longer writable, so treat it as closed
+    for (segment_id_t i = 0; i < tracker->get_capacity(); ++i) {
+      if (tracker->get(i) == segment_state_t::OPEN) {
+	tracker->set(i, segment_state_t::CLOSED);
+      }
+    }
+    logger().debug(
+      "init: {} segments of {} bytes, block_size {}",
+      superblock.segments,
+      superblock.segment_size,
+      superblock.block_size);
+    return init_ertr::now();
+  });
+}
+
+BlockSegmentManager::close_ertr::future<> BlockSegmentManager::close()
+{
+  return device.close().handle_exception([](auto e)
+    -> close_ertr::future<> {
+    logger().error("close: got error {}", e);
+    return crimson::ct_error::input_output_error::make();
+  });
+}
+
+SegmentManager::open_ertr::future<SegmentRef> BlockSegmentManager::open(
+  segment_id_t id)
+{
+  if (id >= get_num_segments())
+    return crimson::ct_error::invarg::make();
+
+  if (tracker->get(id) != segment_state_t::EMPTY)
+    return crimson::ct_error::invarg::make();
+
+  tracker->set(id, segment_state_t::OPEN);
+  return tracker->write_out_segment(
+    device, superblock.tracker_offset, id
+  ).safe_then([this, id] {
+    return open_ertr::make_ready_future<SegmentRef>(
+      new BlockSegment(*this, id));
+  });
+}
+
+SegmentManager::release_ertr::future<> BlockSegmentManager::release(
+  segment_id_t id)
+{
+  if (id >= get_num_segments())
+    return crimson::ct_error::invarg::make();
+
+  if (tracker->get(id) != segment_state_t::CLOSED)
+    return crimson::ct_error::invarg::make();
+
+  // clear the segment header so journal replay won't pick the segment up
+  return seastar::do_with(
+    bufferptr(ceph::buffer::create_page_aligned(superblock.block_size)),
+    [this, id](auto &bp) {
+      bp.zero();
+      return do_write(device, get_offset({id, 0}), bp);
+    }).safe_then([this, id] {
+      tracker->set(id, segment_state_t::EMPTY);
+      return tracker->write_out_segment(
+	device, superblock.tracker_offset, id);
+    });
+}
+
+SegmentManager::read_ertr::future<> BlockSegmentManager::read(
+  paddr_t addr,
+  size_t len,
+  ceph::bufferptr &out)
+{
+  if (addr.segment >= get_num_segments())
+    return crimson::ct_error::invarg::make();
+
+  if (addr.offset + len > (size_t)superblock.segment_size)
+    return crimson::ct_error::invarg::make();
+
+  if (addr.offset % superblock.block_size != 0 ||
+      len % superblock.block_size != 0 ||
+      out.length() < len)
+    return crimson::ct_error::invarg::make();
+
+  logger().debug(
+    "segment_read from segment {} at offset {}, physical offset {}, len {}",
+    addr.segment,
+    addr.offset,
+    get_offset(addr),
+    len);
+
+  if (((uintptr_t)out.c_str() & (CEPH_PAGE_SIZE - 1)) == 0) {
+    return seastar::do_with(
+      bufferptr(out, 0, len),
+      [this, addr](auto &bp) {
+	return do_read(device, get_offset(addr), bp);
+      });
+  }
+
+  // dma needs aligned memory; bounce through an aligned buffer
+  return seastar::do_with(
+    bufferptr(ceph::buffer::create_page_aligned(len)),
+    [this, addr, &out](auto &bp) {
+      return do_read(device, get_offset(addr), bp).safe_then([&out, &bp] {
+	out.copy_in(0, bp.length(), bp.c_str());
+      });
+    });
+}
+
+}
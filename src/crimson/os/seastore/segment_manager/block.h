@@ -0,0 +1,196 @@
+// -*- mode:C++; tab-width:8; c-basic-offset:2; indent-tabs-mode:t -*-
+// vim: ts=8 sw=2 smarttab
+
+#pragma once
+
+#include <boost/intrusive_ptr.hpp>
+#include <boost/smart_ptr/intrusive_ref_counter.hpp>
+#include <seastar/core/file.hh>
+#include <seastar/core/future.hh>
+
+#include "crimson/os/seastore/segment_manager.h"
+
+namespace crimson::os::seastore::segment_manager::block {
+
+using write_ertr = crimson::errorator<
+  crimson::ct_error::input_output_error>;
+using read_ertr = crimson::errorator<
+  crimson::ct_error::input_output_error>;
+
+/**
+ * block_sm_superblock_t
+ *
+ * Written to the first block of the device by mkfs, describes the
+ * layout of the segment state tracker and of the segments.
+ */
+struct block_sm_superblock_t {
+  size_t size = 0;
+  size_t segment_size = 0;
+  size_t block_size = 0;
+
+  size_t segments = 0;
+  uint64_t tracker_offset = 0;
+  uint64_t first_segment_offset = 0;
+
+  DENC(block_sm_superblock_t, v, p) {
+    DENC_START(1, 1, p);
+    denc(v.size, p);
+    denc(v.segment_size, p);
+    denc(v.block_size, p);
+    denc(v.segments, p);
+    denc(v.tracker_offset, p);
+    denc(v.first_segment_offset, p);
+    DENC_FINISH(p);
+  }
+};
+
+enum class segment_state_t : uint8_t {
+  EMPTY = 0,
+  OPEN = 1,
+  CLOSED = 2
+};
+
+/**
+ * SegmentStateTracker
+ *
+ * Persistent state of each segment, one byte per segment, stored in the
+ * blocks following the superblock.  Each state change is written through
+ * before it is acted upon so that a restart sees which segments were in
+ * use.
+ */
+class SegmentStateTracker {
+  const size_t segments;
+  const size_t block_size;
+  bufferptr bptr;
+
+public:
+  static size_t get_raw_size(size_t segments, size_t block_size) {
+    return p2roundup(segments, block_size);
+  }
+
+  SegmentStateTracker(size_t segments, size_t block_size);
+
+  size_t get_size() const {
+    return bptr.length();
+  }
+
+  size_t get_capacity() const {
+    return segments;
+  }
+
+  segment_state_t get(segment_id_t offset) const {
+    ceph_assert(offset < segments);
+    return static_cast<segment_state_t>(bptr.c_str()[offset]);
+  }
+
+  void set(segment_id_t offset, segment_state_t state) {
+    ceph_assert(offset < segments);
+    bptr.c_str()[offset] = static_cast<char>(state);
+  }
+
+  /// write the whole tracker at tracker_offset
+  write_ertr::future<> write_out(
+    seastar::file &device,
+    uint64_t tracker_offset);
+
+  /// write only the block holding the state of segment id
+  write_ertr::future<> write_out_segment(
+    seastar::file &device,
+    uint64_t tracker_offset,
+    segment_id_t id);
+
+  read_ertr::future<> read_in(
+    seastar::file &device,
+    uint64_t tracker_offset);
+};
+
+class BlockSegmentManager;
+class BlockSegment final : public Segment {
+  friend class BlockSegmentManager;
+  BlockSegmentManager &manager;
+  const segment_id_t id;
+  segment_off_t write_pointer = 0;
+public:
+  BlockSegment(BlockSegmentManager &manager, segment_id_t id);
+
+  segment_id_t get_segment_id() const final { return id; }
+  segment_off_t get_write_capacity() const final;
+  segment_off_t get_write_ptr() const final { return write_pointer; }
+  close_ertr::future<> close() final;
+  write_ertr::future<> write(segment_off_t offset, ceph::bufferlist bl) final;
+
+  ~BlockSegment() {}
+};
+
+/**
+ * BlockSegmentManager
+ *
+ * Implements SegmentManager on a block device or file through seastar's
+ * DMA file interface.  Writes are padded to the block size and issued
+ * from page aligned buffers; reads go straight into the caller's buffer
+ * when it is suitably aligned.
+ */
+class BlockSegmentManager final : public SegmentManager {
+  friend class BlockSegment;
+
+  const std::string device_path;
+  seastar::file device;
+  block_sm_superblock_t superblock;
+  std::unique_ptr<SegmentStateTracker> tracker;
+
+  uint64_t get_offset(paddr_t addr) const {
+    return superblock.first_segment_offset +
+      (addr.segment * superblock.segment_size) +
+      addr.offset;
+  }
+
+  Segment::close_ertr::future<> segment_close(segment_id_t id);
+
+  Segment::write_ertr::future<> segment_write(
+    paddr_t addr,
+    ceph::bufferlist bl);
+
+public:
+  using mkfs_ertr = crimson::errorator<
+    crimson::ct_error::input_output_error,
+    crimson::ct_error::invarg>;
+  /// lay out a superblock and an empty segment state tracker on path
+  static mkfs_ertr::future<> mkfs(
+    const std::string &path,
+    size_t segment_size);
+
+  BlockSegmentManager(const std::string &path) : device_path(path) {}
+  ~BlockSegmentManager();
+
+  /// open the device and load the superblock and segment states
+  init_ertr::future<> init() final;
+
+  using close_ertr = crimson::errorator<
+    crimson::ct_error::input_output_error>;
+  close_ertr::future<> close();
+
+  open_ertr::future<SegmentRef> open(segment_id_t id) final;
+
+  release_ertr::future<> release(segment_id_t id) final;
+
+  read_ertr::future<> read(
+    paddr_t addr,
+    size_t len,
+    ceph::bufferptr &out) final;
+
+  size_t get_size() const final {
+    return superblock.segments * superblock.segment_size;
+  }
+  segment_off_t get_block_size() const final {
+    return superblock.block_size;
+  }
+  segment_off_t get_segment_size() const final {
+    return superblock.segment_size;
+  }
+};
+
+}
+
+WRITE_CLASS_DENC_BOUNDED(
+  crimson::os::seastore::segment_manager::block::block_sm_superblock_t
+)
@@ -455,12 +455,15 @@ void PGRecovery::enqueue_push(
 {
   logger().debug("{}: target={} obj={} v={}",
                  __func__, target, obj, v);
+  ++backfill_pushes_in_flight;
   std::ignore = pg->get_recovery_backend()->recover_object(obj, v).\
   handle_exception([] (auto) {
     ceph_abort_msg("got exception on backfill's push");
     return seastar::make_ready_future<>();
   }).then([this, obj] {
     logger().debug("enqueue_push:{}", __func__);
+    assert(backfill_pushes_in_flight > 0);
+    --backfill_pushes_in_flight;
     using BackfillState = crimson::osd::BackfillState;
     start_backfill_recovery(BackfillState::ObjectPushed(std::move(obj)));
   });
@@ -510,8 +513,15 @@ void PGRecovery::update_peers_last_backfill(
 
 bool PGRecovery::budget_available() const
 {
-  // TODO: the limits!
-  return true;
+  // like the classic OSD, a non-zero osd_recovery_max_active overrides
+  // the per device class limits. crimson targets fast devices, so the
+  // ssd limit is used otherwise.
+  using crimson::common::local_conf;
+  auto max_active = local_conf()->osd_recovery_max_active;
+  if (max_active == 0) {
+    max_active = local_conf()->osd_recovery_max_active_ssd;
+  }
+  return backfill_pushes_in_flight < std::max<uint64_t>(max_active, 1);
 }
 
 void PGRecovery::backfilled()
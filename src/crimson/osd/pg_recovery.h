@@ -82,6 +82,8 @@ private:
 
   // backfill begin
   std::unique_ptr<crimson::osd::BackfillState> backfill_state;
+  /// backfill pushes started by enqueue_push() and not yet completed
+  size_t backfill_pushes_in_flight = 0;
 
   template <class EventT>
   void start_backfill_recovery(
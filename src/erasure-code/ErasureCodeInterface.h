@@ -370,6 +370,21 @@ namespace ceph {
     virtual int encode_chunks(const std::set<int> &want_to_encode,
                               std::map<int, bufferlist> *encoded) = 0;
 
+    /**
+     * Return true if **encode_chunks** may be called directly with
+     * caller allocated chunks, one per chunk index, each contiguous,
+     * aligned to 32 bytes and of the size returned by
+     * **get_chunk_size**. The data chunks are filled in and the coding
+     * chunks are computed in place. This lets a caller encode many
+     * stripes into the same coding buffers without going through
+     * **encode** for each of them.
+     *
+     * @return **true** if encode_chunks can be used that way
+     */
+    virtual bool can_encode_chunks_in_place() const {
+      return false;
+    }
+
     /**
      * Decode the **chunks** and store at least **want_to_read**
      * chunks in **decoded**.
@@ -258,8 +258,11 @@ public:
   shard_t* pick_a_shard() {
     // Dirt cheap, see:
     //   http://fossies.org/dox/glibc-2.24/pthread__self_8c_source.html
+    // the thread descriptor sits at the same offset within a page for
+    // every thread, so only the bits above the 4K page offset tell the
+    // threads apart.
     size_t me = (size_t)pthread_self();
-    size_t i = (me >> 3) & ((1 << num_shard_bits) - 1);
+    size_t i = (me >> 12) & ((1 << num_shard_bits) - 1);
     return &shard[i];
   }
 
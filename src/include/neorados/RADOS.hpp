@@ -23,6 +23,7 @@
 #include <string_view>
 #include <type_traits>
 #include <variant>
+#include <vector>
 
 #include <boost/asio.hpp>
 
@@ -603,6 +604,28 @@ public:
     return init.result.get();
   }
 
+  /// one read of a batch; bl, if set, receives the read data
+  struct BatchRead {
+    Object obj;
+    ReadOp op;
+    ceph::buffer::list* bl = nullptr;
+  };
+  /// the first error, if any, and the result of each read in order
+  using BatchSig = void(boost::system::error_code,
+			std::vector<boost::system::error_code>);
+  using BatchComp = ceph::async::Completion<BatchSig>;
+
+  /// submit every read in the batch and complete once, when all are done
+  template<typename CompletionToken>
+  auto execute(const IOContext& ioc, std::vector<BatchRead>&& reads,
+	       CompletionToken&& token) {
+    boost::asio::async_completion<CompletionToken, BatchSig> init(token);
+    execute(ioc, std::move(reads),
+	    BatchComp::create(get_executor(),
+			      std::move(init.completion_handler)));
+    return init.result.get();
+  }
+
   boost::uuids::uuid get_fsid() const noexcept;
 
   using LookupPoolSig = void(boost::system::error_code,
@@ -983,6 +1006,9 @@ private:
 	       std::optional<std::string_view> key,
 	       uint64_t* objver);
 
+  void execute(const IOContext& ioc, std::vector<BatchRead>&& reads,
+	       std::unique_ptr<BatchComp> c);
+
   void lookup_pool(std::string_view name, std::unique_ptr<LookupPoolComp> c);
   void list_pools(std::unique_ptr<LSPoolsComp> c);
   void create_pool_snap(int64_t pool, std::string_view snapName,
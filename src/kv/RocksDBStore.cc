@@ -17,6 +17,7 @@
 #include "rocksdb/cache.h"
 #include "rocksdb/filter_policy.h"
 #include "rocksdb/utilities/convenience.h"
+#include "rocksdb/utilities/table_properties_collectors.h"
 #include "rocksdb/merge_operator.h"
 
 #include "common/perf_counters.h"
@@ -486,6 +487,14 @@ int RocksDBStore::load_rocksdb_options(bool create_if_missing, rocksdb::Options&
     bbt_opts.metadata_block_size = cct->_conf.get_val<Option::size_t>("rocksdb_metadata_block_size");
 
   opt.table_factory.reset(rocksdb::NewBlockBasedTableFactory(bbt_opts));
+  if (cct->_conf.get_val<bool>("rocksdb_cf_compact_on_deletion")) {
+    // mark SSTs written with many tombstones for compaction, so that a PG or
+    // large omap removal does not leave them around to slow down iteration
+    opt.table_properties_collector_factories.emplace_back(
+      rocksdb::NewCompactOnDeletionCollectorFactory(
+	cct->_conf.get_val<uint64_t>("rocksdb_cf_compact_on_deletion_sliding_window"),
+	cct->_conf.get_val<uint64_t>("rocksdb_cf_compact_on_deletion_trigger")));
+  }
   dout(10) << __func__ << " block size " << cct->_conf->rocksdb_block_size
            << ", block_cache size " << byte_u_t(block_cache_size)
 	   << ", row_cache size " << byte_u_t(row_cache_size)
@@ -953,6 +962,10 @@ int RocksDBStore::do_open(ostream &out,
   plb.add_time_avg(l_rocksdb_submit_sync_latency, "submit_sync_latency", "Submit Sync Latency");
   plb.add_u64_counter(l_rocksdb_compact, "compact", "Compactions");
   plb.add_u64_counter(l_rocksdb_compact_range, "compact_range", "Compactions by range");
+  plb.add_u64_counter(l_rocksdb_rm_point_keys, "rm_point_keys",
+    "Point tombstones written while removing key ranges");
+  plb.add_u64_counter(l_rocksdb_rm_range_deletes, "rm_range_deletes",
+    "Range tombstones written while removing key ranges");
   plb.add_u64_counter(l_rocksdb_compact_queue_merge, "compact_queue_merge", "Mergings of ranges in compaction queue");
   plb.add_u64(l_rocksdb_compact_queue_len, "compact_queue_len", "Length of compaction queue");
   plb.add_time_avg(l_rocksdb_write_wal_time, "rocksdb_write_wal_time", "Rocksdb write wal time");
@@ -1139,6 +1152,33 @@ void RocksDBStore::get_statistics(Formatter *f)
       }
       f->close_section();
     }
+    // per column family key counts and sizes, to judge which prefixes are
+    // hot enough to deserve more shards
+    f->open_array_section("rocksdb_column_family_statistics");
+    auto dump_cf = [&](const std::string& prefix,
+		       rocksdb::ColumnFamilyHandle *cf) {
+      uint64_t v;
+      f->open_object_section("column_family");
+      f->dump_string("prefix", prefix);
+      f->dump_string("name", cf->GetName());
+      if (db->GetIntProperty(cf, "rocksdb.estimate-num-keys", &v)) {
+	f->dump_unsigned("estimate_num_keys", v);
+      }
+      if (db->GetIntProperty(cf, "rocksdb.total-sst-files-size", &v)) {
+	f->dump_unsigned("total_sst_files_size", v);
+      }
+      if (db->GetIntProperty(cf, "rocksdb.estimate-pending-compaction-bytes", &v)) {
+	f->dump_unsigned("estimate_pending_compaction_bytes", v);
+      }
+      f->close_section();
+    };
+    dump_cf("", default_cf);
+    for (auto& [prefix, shards] : cf_handles) {
+      for (auto cf : shards.handles) {
+	dump_cf(prefix, cf);
+      }
+    }
+    f->close_section();
   }
   if (cct->_conf->rocksdb_collect_extended_stats) {
     if (dbstats) {
@@ -1423,6 +1463,7 @@ void RocksDBStore::RocksDBTransactionImpl::rmkeys_by_prefix(const string &prefix
     }
     if (cnt == 0) {
 	bat.RollbackToSavePoint();
+	db->logger->inc(l_rocksdb_rm_range_deletes);
 	string endprefix = prefix;
         endprefix.push_back('\x01');
 	bat.DeleteRange(db->default_cf,
@@ -1430,6 +1471,7 @@ void RocksDBStore::RocksDBTransactionImpl::rmkeys_by_prefix(const string &prefix
                         combine_strings(endprefix, string()));
     } else {
       bat.PopSavePoint();
+      db->logger->inc(l_rocksdb_rm_point_keys, db->delete_range_threshold - cnt);
     }
   } else {
     ceph_assert(p_iter->second.handles.size() >= 1);
@@ -1442,11 +1484,14 @@ void RocksDBStore::RocksDBTransactionImpl::rmkeys_by_prefix(const string &prefix
       }
       if (cnt == 0) {
 	bat.RollbackToSavePoint();
+	db->logger->inc(l_rocksdb_rm_range_deletes);
 	string endprefix = "\xff\xff\xff\xff";  // FIXME: this is cheating...
 	bat.DeleteRange(cf, string(), endprefix);
       } else {
 	bat.PopSavePoint();
+	db->logger->inc(l_rocksdb_rm_point_keys, db->delete_range_threshold - cnt);
       }
+      delete it;
     }
   }
 }
@@ -1467,11 +1512,13 @@ void RocksDBStore::RocksDBTransactionImpl::rm_range_keys(const string &prefix,
     }
     if (cnt == 0) {
       bat.RollbackToSavePoint();
+      db->logger->inc(l_rocksdb_rm_range_deletes);
       bat.DeleteRange(db->default_cf,
 		      rocksdb::Slice(combine_strings(prefix, start)),
 		      rocksdb::Slice(combine_strings(prefix, end)));
     } else {
       bat.PopSavePoint();
+      db->logger->inc(l_rocksdb_rm_point_keys, db->delete_range_threshold - cnt);
     }
   } else {
     ceph_assert(p_iter->second.handles.size() >= 1);
@@ -1487,9 +1534,11 @@ void RocksDBStore::RocksDBTransactionImpl::rm_range_keys(const string &prefix,
       }
       if (cnt == 0) {
 	bat.RollbackToSavePoint();
+	db->logger->inc(l_rocksdb_rm_range_deletes);
 	bat.DeleteRange(cf, rocksdb::Slice(start), rocksdb::Slice(end));
       } else {
 	bat.PopSavePoint();
+	db->logger->inc(l_rocksdb_rm_point_keys, db->delete_range_threshold - cnt);
       }
       delete it;
     }
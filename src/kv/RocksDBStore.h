@@ -39,6 +39,8 @@ enum {
   l_rocksdb_submit_sync_latency,
   l_rocksdb_compact,
   l_rocksdb_compact_range,
+  l_rocksdb_rm_point_keys,
+  l_rocksdb_rm_range_deletes,
   l_rocksdb_compact_queue_merge,
   l_rocksdb_compact_queue_len,
   l_rocksdb_write_wal_time,
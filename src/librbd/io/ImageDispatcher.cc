@@ -183,16 +183,19 @@ void ImageDispatcher<I>::finish(int r, ImageDispatchLayer image_dispatch_layer,
   ldout(cct, 20) << "r=" << r << ", tid=" << tid << dendl;
 
   // loop in reverse order from last invoked dispatch layer calling its
-  // handle_finished method
+  // handle_finished method -- jump straight to the next registered layer
+  // instead of probing every layer number in between
   while (image_dispatch_layer != IMAGE_DISPATCH_LAYER_NONE) {
     std::shared_lock locker{this->m_lock};
-    auto it = this->m_dispatches.find(image_dispatch_layer);
-    image_dispatch_layer = static_cast<ImageDispatchLayer>(
-      image_dispatch_layer - 1);
-
-    if (it == this->m_dispatches.end()) {
-      continue;
+    auto it = this->m_dispatches.upper_bound(image_dispatch_layer);
+    if (it == this->m_dispatches.begin()) {
+      break;
+    }
+    --it;
+    if (it->first == IMAGE_DISPATCH_LAYER_NONE) {
+      break;
     }
+    image_dispatch_layer = static_cast<ImageDispatchLayer>(it->first - 1);
 
     // track callback while lock is dropped so that the layer cannot be shutdown
     auto& dispatch_meta = it->second;
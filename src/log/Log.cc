@@ -191,8 +191,13 @@ void Log::submit_entry(Entry&& e)
     m_cond_loggers.wait(lock);
   }
 
+  // the flusher only sleeps once it has found m_new empty, so it is
+  // enough to wake it for the first entry of each batch.
+  bool was_empty = m_new.empty();
   m_new.emplace_back(std::move(e));
-  m_cond_flusher.notify_all();
+  if (was_empty) {
+    m_cond_flusher.notify_all();
+  }
   m_queue_mutex_holder = 0;
 }
 
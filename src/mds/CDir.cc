@@ -1588,7 +1588,12 @@ public:
     if (omap.empty()) {
       omap.swap(omap_more);
     } else {
-      omap.insert(omap_more.begin(), omap_more.end());
+      // the new batch starts after the last key we already have, so move
+      // its nodes over at the end instead of copying and searching for
+      // each of them
+      while (!omap_more.empty()) {
+	omap.insert(omap.end(), omap_more.extract(omap_more.begin()));
+      }
     }
     if (more) {
       dir->_omap_fetch_more(hdrbl, omap, fin);
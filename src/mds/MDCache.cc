@@ -9603,7 +9603,7 @@ MDRequestRef MDCache::request_get(metareqid_t rid)
 void MDCache::request_finish(MDRequestRef& mdr)
 {
   dout(7) << "request_finish " << *mdr << dendl;
-  mdr->mark_event("finishing request");
+  mdr->mark_event_static("finishing request");
 
   // peer finisher?
   if (mdr->has_more() && mdr->more()->peer_commit) {
@@ -9808,7 +9808,7 @@ void MDCache::request_cleanup(MDRequestRef& mdr)
   if (mds->logger)
     log_stat();
 
-  mdr->mark_event("cleaned up request");
+  mdr->mark_event_static("cleaned up request");
 }
 
 void MDCache::request_kill(MDRequestRef& mdr)
@@ -9833,7 +9833,7 @@ void MDCache::request_kill(MDRequestRef& mdr)
   }
 
   mdr->killed = true;
-  mdr->mark_event("killing request");
+  mdr->mark_event_static("killing request");
 
   if (mdr->committing) {
     dout(10) << "request_kill " << *mdr << " -- already committing, remove it from sesssion requests" << dendl;
@@ -11992,7 +11992,7 @@ void MDCache::_fragment_logged(MDRequestRef& mdr)
 
   dout(10) << "fragment_logged " << basedirfrag << " bits " << info.bits
 	   << " on " << *diri << dendl;
-  mdr->mark_event("prepare logged");
+  mdr->mark_event_static("prepare logged");
 
   if (diri->is_auth())
     diri->pop_and_dirty_projected_inode(mdr->ls);
@@ -12023,7 +12023,7 @@ void MDCache::_fragment_stored(MDRequestRef& mdr)
 
   dout(10) << "fragment_stored " << basedirfrag << " bits " << info.bits
 	   << " on " << *diri << dendl;
-  mdr->mark_event("new frags stored");
+  mdr->mark_event_static("new frags stored");
 
   // tell peers
   mds_rank_t diri_auth = (first->is_subtree_root() && !diri->is_auth()) ?
@@ -12097,7 +12097,7 @@ void MDCache::_fragment_committed(dirfrag_t basedirfrag, const MDRequestRef& mdr
 {
   dout(10) << "fragment_committed " << basedirfrag << dendl;
   if (mdr)
-    mdr->mark_event("commit logged");
+    mdr->mark_event_static("commit logged");
 
   ufragment &uf = uncommitted_fragments.at(basedirfrag);
 
@@ -12135,7 +12135,7 @@ void MDCache::_fragment_old_purged(dirfrag_t basedirfrag, int bits, const MDRequ
 {
   dout(10) << "fragment_old_purged " << basedirfrag << dendl;
   if (mdr)
-    mdr->mark_event("old frags purged");
+    mdr->mark_event_static("old frags purged");
 
   EFragment *le = new EFragment(mds->mdlog, EFragment::OP_FINISH, basedirfrag, bits);
   mds->mdlog->start_submit_entry(le);
@@ -12157,7 +12157,7 @@ void MDCache::_fragment_old_purged(dirfrag_t basedirfrag, int bits, const MDRequ
     if (it->second.notify_ack_waiting.empty())
       fragment_maybe_finish(it);
     else
-      mdr->mark_event("wating for notify acks");
+      mdr->mark_event_static("wating for notify acks");
   }
 }
 
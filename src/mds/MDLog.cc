@@ -356,6 +356,15 @@ void MDLog::_submit_thread()
 
   std::unique_lock locker{submit_mutex};
 
+  // group commit: a flush requested while more events are already queued
+  // is deferred until the queue drains, so that a burst of requests that
+  // each flush turns into a few large journal writes rather than one small
+  // write per request.  bound the deferral so a steady stream of events
+  // cannot hold back the flush indefinitely.
+  static constexpr unsigned max_deferred_events = 128;
+  bool flush_deferred = false;
+  unsigned deferred_events = 0;
+
   while (!mds->is_daemon_stopping()) {
     if (g_conf()->mds_log_pause) {
       submit_cond.wait(locker);
@@ -364,6 +373,15 @@ void MDLog::_submit_thread()
 
     map<uint64_t,list<PendingEvent> >::iterator it = pending_events.begin();
     if (it == pending_events.end()) {
+      if (flush_deferred) {
+	flush_deferred = false;
+	deferred_events = 0;
+	locker.unlock();
+	journaler->flush();
+	locker.lock();
+	unflushed = 0;
+	continue;
+      }
       submit_cond.wait(locker);
       continue;
     }
@@ -377,6 +395,19 @@ void MDLog::_submit_thread()
     PendingEvent data = it->second.front();
     it->second.pop_front();
 
+    bool do_flush = false;
+    if (data.flush || flush_deferred) {
+      bool more = !it->second.empty() || std::next(it) != pending_events.end();
+      if (more && deferred_events < max_deferred_events) {
+	flush_deferred = true;
+	deferred_events++;
+      } else {
+	do_flush = true;
+	flush_deferred = false;
+	deferred_events = 0;
+      }
+    }
+
     locker.unlock();
 
     if (data.le) {
@@ -410,7 +441,7 @@ void MDLog::_submit_thread()
 
       journaler->wait_for_flush(fin);
 
-      if (data.flush)
+      if (do_flush)
 	journaler->flush();
 
       if (logger)
@@ -426,12 +457,12 @@ void MDLog::_submit_thread()
 	fin2->set_write_pos(journaler->get_write_pos());
 	journaler->wait_for_flush(fin2);
       }
-      if (data.flush)
+      if (do_flush)
 	journaler->flush();
     }
 
     locker.lock();
-    if (data.flush)
+    if (do_flush)
       unflushed = 0;
     else if (data.le)
       unflushed++;
@@ -148,7 +148,7 @@ protected:
   MDRequestRef mdr;
   void pre_finish(int r) override {
     if (mdr)
-      mdr->mark_event("journal_committed: ");
+      mdr->mark_event_static("journal_committed: ");
   }
 public:
   explicit ServerLogContext(Server *s) : server(s) {
@@ -2070,7 +2070,7 @@ void Server::early_reply(MDRequestRef& mdr, CInode *tracei, CDentry *tracedn)
   perf_gather_op_latency(req, lat);
   dout(20) << "lat " << lat << dendl;
 
-  mdr->mark_event("early_replied");
+  mdr->mark_event_static("early_replied");
 }
 
 /*
@@ -2087,7 +2087,7 @@ void Server::reply_client_request(MDRequestRef& mdr, const ref_t<MClientReply> &
 	   << " (" << cpp_strerror(reply->get_result())
 	   << ") " << *req << dendl;
 
-  mdr->mark_event("replying");
+  mdr->mark_event_static("replying");
 
   Session *session = mdr->session;
 
@@ -4830,7 +4830,7 @@ void Server::handle_client_file_setlock(MDRequestRef& mdr)
 	mdr->more()->flock_was_waiting = true;
 	mds->locker->drop_locks(mdr.get());
 	mdr->drop_local_auth_pins();
-	mdr->mark_event("failed to add lock, waiting");
+	mdr->mark_event_static("failed to add lock, waiting");
 	mdr->mark_nowarn();
 	cur->add_waiter(CInode::WAIT_FLOCK, new C_MDS_RetryRequest(mdcache, mdr));
       }
@@ -727,8 +727,8 @@ PyObject* ActivePyModules::with_perf_counters(
   if (metadata) {
     std::lock_guard l2(metadata->lock);
     if (metadata->perf_counters.instances.count(path)) {
-      auto counter_instance = metadata->perf_counters.instances.at(path);
-      auto counter_type = metadata->perf_counters.types.at(path);
+      auto& counter_instance = metadata->perf_counters.instances.at(path);
+      auto& counter_type = metadata->perf_counters.types.at(path);
       fct(counter_instance, counter_type, f);
     } else {
       dout(4) << "Missing counter: '" << path << "' ("
@@ -831,10 +831,10 @@ PyObject* ActivePyModules::get_perf_schema_python(
       f.open_object_section(ceph::to_string(key).c_str());
 
       std::lock_guard l(state->lock);
-      for (auto ctr_inst_iter : state->perf_counters.instances) {
+      for (const auto& ctr_inst_iter : state->perf_counters.instances) {
         const auto &counter_name = ctr_inst_iter.first;
 	f.open_object_section(counter_name.c_str());
-	auto type = state->perf_counters.types[counter_name];
+	const auto& type = state->perf_counters.types[counter_name];
 	f.dump_string("description", type.description);
 	if (!type.nick.empty()) {
 	  f.dump_string("nick", type.nick);
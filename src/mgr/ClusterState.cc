@@ -74,9 +74,9 @@ void ClusterState::ingest_pgstats(ref_t<MPGStats> stats)
   const int from = stats->get_orig_source().num();
   pending_inc.update_stat(from, std::move(stats->osd_stat));
 
-  for (auto p : stats->pg_stat) {
+  for (auto& p : stats->pg_stat) {
     pg_t pgid = p.first;
-    const auto &pg_stats = p.second;
+    auto &pg_stats = p.second;
 
     // In case we're hearing about a PG that according to last
     // OSDMap update should not exist
@@ -100,19 +100,21 @@ void ClusterState::ingest_pgstats(ref_t<MPGStats> stats)
       continue;
     }
     // In case we already heard about more recent stats from this PG
-    // from another OSD
+    // from another OSD.  The primary re-sends the stats it last
+    // published in every report, under the same version, so an equal
+    // version means nothing changed and there is nothing to apply.
     const auto q = pg_map.pg_stat.find(pgid);
     if (q != pg_map.pg_stat.end() &&
-	q->second.get_version_pair() > pg_stats.get_version_pair()) {
-      dout(15) << " had " << pgid << " from "
+	q->second.get_version_pair() >= pg_stats.get_version_pair()) {
+      dout(20) << " had " << pgid << " from "
 	       << q->second.reported_epoch << ":"
 	       << q->second.reported_seq << dendl;
       continue;
     }
 
-    pending_inc.pg_stat_updates[pgid] = pg_stats;
+    pending_inc.pg_stat_updates[pgid] = std::move(pg_stats);
   }
-  for (auto p : stats->pool_stat) {
+  for (auto& p : stats->pool_stat) {
     pending_inc.pool_statfs_updates[std::make_pair(p.first, from)] = p.second;
   }
 }
@@ -237,7 +237,7 @@ void Elector::message_victory(const std::set<int>& quorum)
 
 void Elector::handle_propose(MonOpRequestRef op)
 {
-  op->mark_event("elector:handle_propose");
+  op->mark_event_static("elector:handle_propose");
   auto m = op->get_req<MMonElection>();
   dout(5) << "handle_propose from " << m->get_source() << dendl;
   int from = m->get_source().num();
@@ -278,7 +278,7 @@ void Elector::handle_propose(MonOpRequestRef op)
 
 void Elector::handle_ack(MonOpRequestRef op)
 {
-  op->mark_event("elector:handle_ack");
+  op->mark_event_static("elector:handle_ack");
   auto m = op->get_req<MMonElection>();
   dout(5) << "handle_ack from " << m->get_source() << dendl;
   int from = m->get_source().num();
@@ -327,7 +327,7 @@ void Elector::handle_ack(MonOpRequestRef op)
 
 void Elector::handle_victory(MonOpRequestRef op)
 {
-  op->mark_event("elector:handle_victory");
+  op->mark_event_static("elector:handle_victory");
   auto m = op->get_req<MMonElection>();
   dout(5) << "handle_victory from " << m->get_source()
           << " quorum_features " << m->quorum_features
@@ -357,7 +357,7 @@ void Elector::handle_victory(MonOpRequestRef op)
 
 void Elector::nak_old_peer(MonOpRequestRef op)
 {
-  op->mark_event("elector:nak_old_peer");
+  op->mark_event_static("elector:nak_old_peer");
   auto m = op->get_req<MMonElection>();
   uint64_t supported_features = m->get_connection()->get_features();
   uint64_t required_features = mon->get_required_features();
@@ -379,7 +379,7 @@ void Elector::nak_old_peer(MonOpRequestRef op)
 
 void Elector::handle_nak(MonOpRequestRef op)
 {
-  op->mark_event("elector:handle_nak");
+  op->mark_event_static("elector:handle_nak");
   auto m = op->get_req<MMonElection>();
   dout(1) << "handle_nak from " << m->get_source()
 	  << " quorum_features " << m->quorum_features
@@ -409,7 +409,7 @@ void Elector::handle_nak(MonOpRequestRef op)
 
 void Elector::dispatch(MonOpRequestRef op)
 {
-  op->mark_event("elector:dispatch");
+  op->mark_event_static("elector:dispatch");
   ceph_assert(op->is_type_election());
 
   switch (op->get_req()->get_type()) {
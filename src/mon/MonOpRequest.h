@@ -25,16 +25,16 @@ struct MonOpRequest : public TrackedOp {
   friend class OpTracker;
 
   void mark_dispatch() {
-    mark_event("monitor_dispatch");
+    mark_event_static("monitor_dispatch");
   }
   void mark_wait_for_quorum() {
-    mark_event("wait_for_quorum");
+    mark_event_static("wait_for_quorum");
   }
   void mark_zap() {
-    mark_event("monitor_zap");
+    mark_event_static("monitor_zap");
   }
   void mark_forwarded() {
-    mark_event("forwarded");
+    mark_event_static("forwarded");
     forwarded_to_leader = true;
   }
 
@@ -206,11 +206,11 @@ struct C_MonOp : public Context
 
   void finish(int r) override {
     if (op && r == -ECANCELED) {
-      op->mark_event("callback canceled");
+      op->mark_event_static("callback canceled");
     } else if (op && r == -EAGAIN) {
-      op->mark_event("callback retry");
+      op->mark_event_static("callback retry");
     } else if (op && r == 0) {
-      op->mark_event("callback finished");
+      op->mark_event_static("callback finished");
     }
     _finish(r);
   }
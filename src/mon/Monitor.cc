@@ -3930,7 +3930,7 @@ void Monitor::reply_tell_command(
 
 void Monitor::forward_request_leader(MonOpRequestRef op)
 {
-  op->mark_event(__func__);
+  op->mark_event_static(__func__);
 
   int mon = get_leader();
   MonSession *session = op->get_session();
@@ -4062,7 +4062,7 @@ void Monitor::handle_forward(MonOpRequestRef op)
 
 void Monitor::send_reply(MonOpRequestRef op, Message *reply)
 {
-  op->mark_event(__func__);
+  op->mark_event_static(__func__);
 
   MonSession *session = op->get_session();
   ceph_assert(session);
@@ -4076,7 +4076,7 @@ void Monitor::send_reply(MonOpRequestRef op, Message *reply)
     dout(2) << "send_reply no connection, dropping reply " << *reply
 	    << " to " << req << " " << *req << dendl;
     reply->put();
-    op->mark_event("reply: no connection");
+    op->mark_event_static("reply: no connection");
     return;
   }
 
@@ -4084,7 +4084,7 @@ void Monitor::send_reply(MonOpRequestRef op, Message *reply)
     dout(2) << "send_reply no connection, dropping reply " << *reply
 	    << " to " << req << " " << *req << dendl;
     reply->put();
-    op->mark_event("reply: no connection");
+    op->mark_event_static("reply: no connection");
     return;
   }
 
@@ -4093,10 +4093,10 @@ void Monitor::send_reply(MonOpRequestRef op, Message *reply)
 	     << " via " << session->proxy_con->get_peer_addr()
 	     << " for request " << *req << dendl;
     session->proxy_con->send_message(new MRoute(session->proxy_tid, reply));
-    op->mark_event("reply: send routed request");
+    op->mark_event_static("reply: send routed request");
   } else {
     session->con->send_message(reply);
-    op->mark_event("reply: send");
+    op->mark_event_static("reply: send");
   }
 }
 
@@ -4110,11 +4110,11 @@ void Monitor::no_reply(MonOpRequestRef op)
 	     << " via " << session->proxy_con->get_peer_addr()
 	     << " for request " << *req << dendl;
     session->proxy_con->send_message(new MRoute(session->proxy_tid, NULL));
-    op->mark_event("no_reply: send routed request");
+    op->mark_event_static("no_reply: send routed request");
   } else {
     dout(10) << "no_reply to " << req->get_source_inst()
              << " " << *req << dendl;
-    op->mark_event("no_reply");
+    op->mark_event_static("no_reply");
   }
 }
 
@@ -4174,7 +4174,7 @@ void Monitor::resend_routed_requests()
 
     if (mon == rank) {
       dout(10) << " requeue for self tid " << rr->tid << dendl;
-      rr->op->mark_event("retry routed request");
+      rr->op->mark_event_static("retry routed request");
       retry.push_back(new C_RetryMessage(this, rr->op));
       if (rr->session) {
         ceph_assert(rr->session->routed_request_tids.count(p->first));
@@ -4185,7 +4185,7 @@ void Monitor::resend_routed_requests()
       auto q = rr->request_bl.cbegin();
       PaxosServiceMessage *req =
 	(PaxosServiceMessage *)decode_message(cct, 0, q);
-      rr->op->mark_event("resend forwarded message to leader");
+      rr->op->mark_event_static("resend forwarded message to leader");
       dout(10) << " resend to mon." << mon << " tid " << rr->tid << " " << *req
 	       << dendl;
       MForward *forward = new MForward(rr->tid,
@@ -4292,7 +4292,7 @@ void Monitor::_ms_dispatch(Message *m)
 
   MonOpRequestRef op = op_tracker.create_request<MonOpRequest>(m);
   bool src_is_mon = op->is_src_mon();
-  op->mark_event("mon:_ms_dispatch");
+  op->mark_event_static("mon:_ms_dispatch");
   MonSession *s = op->get_session();
   if (s && s->closed) {
     return;
@@ -4388,7 +4388,7 @@ void Monitor::_ms_dispatch(Message *m)
 
 void Monitor::dispatch_op(MonOpRequestRef op)
 {
-  op->mark_event("mon:dispatch_op");
+  op->mark_event_static("mon:dispatch_op");
   MonSession *s = op->get_session();
   ceph_assert(s);
   if (s->closed) {
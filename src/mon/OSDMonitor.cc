@@ -775,6 +775,7 @@ void OSDMonitor::update_from_paxos(bool *need_bootstrap)
     dout(7) << __func__ << " loading latest full map e" << latest_full << dendl;
     osdmap = OSDMap();
     osdmap.decode(latest_bl);
+    mapping_stale = true;
   }
 
   bufferlist bl;
@@ -815,6 +816,9 @@ void OSDMonitor::update_from_paxos(bool *need_bootstrap)
     OSDMap::Incremental inc(inc_bl);
     err = osdmap.apply_incremental(inc);
     ceph_assert(err == 0);
+    if (inc.may_change_pg_mapping()) {
+      mapping_stale = true;
+    }
 
     if (!t)
       t.reset(new MonitorDBStore::Transaction);
@@ -1020,6 +1024,21 @@ void OSDMonitor::start_mapping()
   }
   if (!osdmap.get_pools().empty()) {
     auto fin = new C_UpdateCreatingPGs(this, osdmap.get_epoch());
+    if (!mapping_stale &&
+	mapping_started_epoch &&
+	mapping.get_epoch() == mapping_started_epoch) {
+      // the last mapping completed and no incremental since then touched
+      // anything that feeds pg_to_up_acting_osds; it is still accurate
+      dout(10) << __func__ << " mapping e" << mapping.get_epoch()
+	       << " still valid, not remapping" << dendl;
+      mapping.update_epoch(osdmap);
+      mapping_started_epoch = osdmap.get_epoch();
+      mapping_job = nullptr;
+      fin->complete(0);
+      return;
+    }
+    mapping_stale = false;
+    mapping_started_epoch = osdmap.get_epoch();
     mapping_job = mapping.start_update(osdmap, mapper,
 				       g_conf()->mon_osd_mapping_pgs_per_chunk);
     dout(10) << __func__ << " started mapping job " << mapping_job.get()
@@ -1547,6 +1566,12 @@ void OSDMonitor::encode_pending(MonitorDBStore::TransactionRef t)
 	maybe_prime_pg_temp();
       }
     } 
+  } else if (!osdmap.get_pools().empty() &&
+	     mapping.get_epoch() == osdmap.get_epoch()) {
+    // start_mapping() found the previous mapping still valid
+    if (g_conf()->mon_osd_prime_pg_temp) {
+      maybe_prime_pg_temp();
+    }
   } else if (g_conf()->mon_osd_prime_pg_temp) {
     dout(1) << __func__ << " skipping prime_pg_temp; mapping job did not start"
 	    << dendl;
@@ -3331,7 +3356,7 @@ void OSDMonitor::process_failures()
       while (!ls.empty()) {
         MonOpRequestRef o = ls.front();
         if (o) {
-          o->mark_event(__func__);
+          o->mark_event_static(__func__);
           MOSDFailure *m = o->get_req<MOSDFailure>();
           send_latest(o, m->get_epoch());
 	  mon->no_reply(o);
@@ -4429,7 +4454,7 @@ void OSDMonitor::send_incremental(MonOpRequestRef op, epoch_t first)
     MRoute *r = new MRoute(s->proxy_tid, NULL);
     r->send_osdmap_first = first;
     s->proxy_con->send_message(r);
-    op->mark_event("reply: send routed send_osdmap_first reply");
+    op->mark_event_static("reply: send routed send_osdmap_first reply");
   } else {
     // do it ourselves
     send_incremental(first, s, false, op);
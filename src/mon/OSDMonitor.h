@@ -390,6 +390,8 @@ private:
   ParallelPGMapper mapper;                        ///< for background pg work
   OSDMapMapping mapping;                          ///< pg <-> osd mappings
   std::unique_ptr<ParallelPGMapper::Job> mapping_job;  ///< background mapping job
+  epoch_t mapping_started_epoch = 0;  ///< epoch of the last mapping we started
+  bool mapping_stale = true;  ///< an applied incremental may change mappings
   void start_mapping();
 
   void update_logger();
@@ -1180,7 +1180,7 @@ public:
    */
   void wait_for_active(MonOpRequestRef op, Context *c) {
     if (op)
-      op->mark_event("paxos:wait_for_active");
+      op->mark_event_static("paxos:wait_for_active");
     waiting_for_active.push_back(c);
   }
   void wait_for_active(Context *c) {
@@ -1277,7 +1277,7 @@ public:
   void wait_for_readable(MonOpRequestRef op, Context *onreadable) {
     ceph_assert(!is_readable());
     if (op)
-      op->mark_event("paxos:wait_for_readable");
+      op->mark_event_static("paxos:wait_for_readable");
     waiting_for_readable.push_back(onreadable);
   }
   void wait_for_readable(Context *onreadable) {
@@ -1319,7 +1319,7 @@ public:
   void wait_for_writeable(MonOpRequestRef op, Context *c) {
     ceph_assert(!is_writeable());
     if (op)
-      op->mark_event("paxos:wait_for_writeable");
+      op->mark_event_static("paxos:wait_for_writeable");
     waiting_for_writeable.push_back(c);
   }
   void wait_for_writeable(Context *c) {
@@ -38,7 +38,7 @@ bool PaxosService::dispatch(MonOpRequestRef op)
 {
   ceph_assert(op->is_type_service() || op->is_type_command());
   auto m = op->get_req<PaxosServiceMessage>();
-  op->mark_event("psvc:dispatch");
+  op->mark_event_static("psvc:dispatch");
 
   dout(10) << __func__ << " " << m << " " << *m
 	   << " from " << m->get_orig_source_inst()
@@ -88,12 +88,15 @@ void DispatchQueue::enqueue(const ref_t<Message>& m, int priority, uint64_t id)
   }
   ldout(cct,20) << "queue " << m << " prio " << priority << dendl;
   add_arrival(m);
+  // the dispatch thread only sleeps once it has drained mqueue
+  bool was_empty = mqueue.empty();
   if (priority >= CEPH_MSG_PRIO_LOW) {
     mqueue.enqueue_strict(id, priority, QueueItem(m));
   } else {
     mqueue.enqueue(id, priority, m->get_cost(), QueueItem(m));
   }
-  cond.notify_all();
+  if (was_empty)
+    cond.notify_all();
 }
 
 void DispatchQueue::local_delivery(const ref_t<Message>& m, int priority)
@@ -69,21 +69,16 @@ class DispatchQueue {
 
   PrioritizedQueue<QueueItem, uint64_t> mqueue;
 
+  // (recv_stamp, message) is unique and the stamp does not change while
+  // the message is queued, so it doubles as the lookup key on removal
   std::set<std::pair<double, ceph::ref_t<Message>>> marrival;
-  std::map<ceph::ref_t<Message>, decltype(marrival)::iterator> marrival_map;
   void add_arrival(const ceph::ref_t<Message>& m) {
-    marrival_map.insert(
-      make_pair(
-	m,
-	marrival.insert(std::make_pair(m->get_recv_stamp(), m)).first
-	)
-      );
+    marrival.insert(std::make_pair(m->get_recv_stamp(), m));
   }
   void remove_arrival(const ceph::ref_t<Message>& m) {
-    auto it = marrival_map.find(m);
-    ceph_assert(it != marrival_map.end());
-    marrival.erase(it->second);
-    marrival_map.erase(it);
+    auto it = marrival.find(std::make_pair(m->get_recv_stamp(), m));
+    ceph_assert(it != marrival.end());
+    marrival.erase(it);
   }
 
   std::atomic<uint64_t> next_id;
@@ -137,6 +137,8 @@ int EventCenter::init(int nevent, unsigned center_id, const std::string &type)
 
   file_events.resize(nevent);
   this->nevent = nevent;
+  busy_poll_window = std::chrono::microseconds(
+    cct->_conf.get_val<uint64_t>("ms_async_busy_poll_us"));
 
   if (!driver->need_wakeup())
     return 0;
@@ -382,7 +384,8 @@ int EventCenter::process_events(unsigned timeout_microseconds,  ceph::timespan *
     }
   }
 
-  bool blocking = pollers.empty() && !external_num_events.load();
+  bool blocking = pollers.empty() && !external_num_events.load() &&
+    !is_busy_polling();
   if (!blocking)
     timeout_microseconds = 0;
   tv.tv_sec = timeout_microseconds / 1000000;
@@ -441,6 +444,9 @@ int EventCenter::process_events(unsigned timeout_microseconds,  ceph::timespan *
       numevents += pollers[i]->poll();
   }
 
+  if (numevents && busy_poll_window.count())
+    busy_poll_until = ceph::mono_clock::now() + busy_poll_window;
+
   if (working_dur)
     *working_dur = ceph::mono_clock::now() - working_start;
   return numevents;
@@ -175,6 +175,9 @@ class EventCenter {
   EventCallbackRef notify_handler;
   unsigned center_id;
   AssociatedCenters *global_centers = nullptr;
+  // after handling events, poll without blocking for this long
+  std::chrono::microseconds busy_poll_window{0};
+  ceph::mono_clock::time_point busy_poll_until;
 
   int process_time_events();
   FileEvent *_get_file_event(int fd) {
@@ -196,6 +199,10 @@ class EventCenter {
   void set_owner();
   pthread_t get_owner() const { return owner; }
   unsigned get_id() const { return center_id; }
+  bool is_busy_polling() const {
+    return busy_poll_window.count() &&
+      ceph::mono_clock::now() < busy_poll_until;
+  }
 
   EventDriver *get_driver() { return driver; }
 
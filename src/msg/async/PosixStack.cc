@@ -21,6 +21,10 @@
 #include <errno.h>
 
 #include <algorithm>
+#include <deque>
+#if defined(__linux__)
+#include <linux/errqueue.h>
+#endif
 
 #include "PosixStack.h"
 
@@ -37,16 +41,48 @@
 #undef dout_prefix
 #define dout_prefix *_dout << "PosixStack "
 
+#if defined(__linux__) && defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY) && \
+    defined(SO_EE_ORIGIN_ZEROCOPY)
+#define HAVE_MSG_ZEROCOPY
+#endif
+
 class PosixConnectedSocketImpl final : public ConnectedSocketImpl {
   ceph::NetHandler &handler;
   int _fd;
   entity_addr_t sa;
   bool connected;
+  PerfCounters *logger;
+
+#ifdef HAVE_MSG_ZEROCOPY
+  bool zerocopy = false;
+  uint64_t zerocopy_threshold = 0;
+  // id the kernel will give the next successful MSG_ZEROCOPY sendmsg
+  uint32_t zerocopy_next_id = 0;
+  // sent data the kernel may still reference, keyed by the id of the
+  // last sendmsg that covered it
+  std::deque<std::pair<uint32_t, ceph::buffer::list>> zerocopy_pending;
+#endif
 
  public:
   explicit PosixConnectedSocketImpl(ceph::NetHandler &h, const entity_addr_t &sa,
-				    int f, bool connected)
-      : handler(h), _fd(f), sa(sa), connected(connected) {}
+				    int f, bool connected, Worker *w)
+      : handler(h), _fd(f), sa(sa), connected(connected),
+	logger(w->get_perf_counter()) {
+#ifdef HAVE_MSG_ZEROCOPY
+    CephContext *cct = w->cct;
+    if (cct->_conf->ms_tcp_zerocopy) {
+      int on = 1;
+      if (::setsockopt(_fd, SOL_SOCKET, SO_ZEROCOPY, &on, sizeof(on)) == 0) {
+	zerocopy = true;
+	zerocopy_threshold = cct->_conf->ms_tcp_zerocopy_threshold;
+      } else {
+	int r = -errno;
+	ldout(cct, 1) << __func__ << " setsockopt SO_ZEROCOPY failed: "
+		      << cpp_strerror(r) << dendl;
+      }
+    }
+#endif
+  }
 
   int is_connected() override {
     if (connected)
@@ -64,6 +100,11 @@ class PosixConnectedSocketImpl final : public ConnectedSocketImpl {
   }
 
   ssize_t read(char *buf, size_t len) override {
+#ifdef HAVE_MSG_ZEROCOPY
+    // completions raise EPOLLERR, which wakes us up as readable
+    if (!zerocopy_pending.empty())
+      reap_zerocopy();
+#endif
     ssize_t r = ::read(_fd, buf, len);
     if (r < 0)
       r = -errno;
@@ -73,22 +114,60 @@ class PosixConnectedSocketImpl final : public ConnectedSocketImpl {
   // return the sent length
   // < 0 means error occurred
   #ifndef _WIN32
-  static ssize_t do_sendmsg(int fd, struct msghdr &msg, unsigned len, bool more)
+#ifdef HAVE_MSG_ZEROCOPY
+  // release the buffers of every send the kernel is done with
+  void reap_zerocopy() {
+    while (!zerocopy_pending.empty()) {
+      struct msghdr msg;
+      char control[CMSG_SPACE(sizeof(struct sock_extended_err)) + 64];
+      memset(&msg, 0, sizeof(msg));
+      msg.msg_control = control;
+      msg.msg_controllen = sizeof(control);
+      if (::recvmsg(_fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+	break;
+      for (auto cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm)) {
+	if (!((cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR) ||
+	      (cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR)))
+	  continue;
+	auto serr = reinterpret_cast<struct sock_extended_err*>(CMSG_DATA(cm));
+	if (serr->ee_errno != 0 || serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+	  continue;
+	// ids [ee_info, ee_data] completed
+	if (serr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED)
+	  logger->inc(l_msgr_send_zerocopy_copied);
+	uint32_t hi = serr->ee_data;
+	while (!zerocopy_pending.empty() &&
+	       (int32_t)(zerocopy_pending.front().first - hi) <= 0) {
+	  zerocopy_pending.pop_front();
+	}
+      }
+    }
+  }
+#endif
+
+  static ssize_t do_sendmsg(int fd, struct msghdr &msg, unsigned len, bool more,
+			    int flags = 0, uint32_t *calls = nullptr)
   {
     size_t sent = 0;
     while (1) {
       MSGR_SIGPIPE_STOPPER;
       ssize_t r;
-      r = ::sendmsg(fd, &msg, MSG_NOSIGNAL | (more ? MSG_MORE : 0));
+      r = ::sendmsg(fd, &msg, MSG_NOSIGNAL | (more ? MSG_MORE : 0) | flags);
       if (r < 0) {
         if (errno == EINTR) {
           continue;
         } else if (errno == EAGAIN) {
           break;
+        } else if (errno == ENOBUFS && flags) {
+          // out of optmem for completions; copy the rest instead
+          flags = 0;
+          continue;
         }
         return -errno;
       }
 
+      if (flags && calls)
+        ++*calls;
       sent += r;
       if (len == sent) break;
 
@@ -109,6 +188,16 @@ class PosixConnectedSocketImpl final : public ConnectedSocketImpl {
   }
 
   ssize_t send(ceph::buffer::list &bl, bool more) override {
+    int flags = 0;
+    uint32_t zerocopy_calls = 0;
+#ifdef HAVE_MSG_ZEROCOPY
+    if (zerocopy) {
+      if (!zerocopy_pending.empty())
+	reap_zerocopy();
+      if (bl.length() >= zerocopy_threshold)
+	flags = MSG_ZEROCOPY;
+    }
+#endif
     size_t sent_bytes = 0;
     auto pb = std::cbegin(bl.buffers());
     uint64_t left_pbrs = bl.get_num_buffers();
@@ -128,7 +217,8 @@ class PosixConnectedSocketImpl final : public ConnectedSocketImpl {
 	msglen += pb->length();
 	++pb;
       }
-      ssize_t r = do_sendmsg(_fd, msg, msglen, left_pbrs || more);
+      ssize_t r = do_sendmsg(_fd, msg, msglen, left_pbrs || more,
+			     flags, &zerocopy_calls);
       if (r < 0)
         return r;
 
@@ -145,8 +235,16 @@ class PosixConnectedSocketImpl final : public ConnectedSocketImpl {
         bl.splice(sent_bytes, bl.length()-sent_bytes, &swapped);
         bl.swap(swapped);
       } else {
-        bl.clear();
+        swapped.swap(bl);
+      }
+#ifdef HAVE_MSG_ZEROCOPY
+      if (zerocopy_calls) {
+        // the kernel references these pages until it reports completion
+        logger->inc(l_msgr_send_zerocopy_bytes, sent_bytes);
+        zerocopy_next_id += zerocopy_calls;
+        zerocopy_pending.emplace_back(zerocopy_next_id - 1, std::move(swapped));
       }
+#endif
     }
 
     return static_cast<ssize_t>(sent_bytes);
@@ -254,7 +352,8 @@ int PosixServerSocketImpl::accept(ConnectedSocket *sock, const SocketOptions &op
   out->set_sockaddr((sockaddr*)&ss);
   handler.set_priority(sd, opt.priority, out->get_family());
 
-  std::unique_ptr<PosixConnectedSocketImpl> csi(new PosixConnectedSocketImpl(handler, *out, sd, true));
+  std::unique_ptr<PosixConnectedSocketImpl> csi(
+    new PosixConnectedSocketImpl(handler, *out, sd, true, w));
   *sock = ConnectedSocket(std::move(csi));
   return 0;
 }
@@ -323,7 +422,8 @@ int PosixWorker::connect(const entity_addr_t &addr, const SocketOptions &opts, C
 
   net.set_priority(sd, opts.priority, addr.get_family());
   *socket = ConnectedSocket(
-      std::unique_ptr<PosixConnectedSocketImpl>(new PosixConnectedSocketImpl(net, addr, sd, !opts.nonblock)));
+      std::unique_ptr<PosixConnectedSocketImpl>(new PosixConnectedSocketImpl(net, addr, sd, !opts.nonblock,
+				       this)));
   return 0;
 }
 
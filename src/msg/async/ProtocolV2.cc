@@ -551,6 +551,14 @@ ssize_t ProtocolV2::write_message(Message *m, bool more) {
                  << " off=" << header2.data_off
                  << dendl;
   ssize_t total_send_size = connection->outgoing_bl.length();
+  if (more && static_cast<uint64_t>(total_send_size) <
+                cct->_conf->ms_async_send_batch_bytes) {
+    // more messages are queued; let their frames join this send
+    ldout(cct, 20) << __func__ << " batching " << m << ", "
+                   << total_send_size << " bytes pending" << dendl;
+    m->put();
+    return 0;
+  }
   ssize_t rc = connection->_try_send(more);
   if (rc < 0) {
     ldout(cct, 1) << __func__ << " error sending " << m << ", "
@@ -50,11 +50,16 @@ std::function<void ()> NetworkStack::add_thread(unsigned worker_id)
         ldout(cct, 30) << __func__ << " calling event process" << dendl;
 
         ceph::timespan dur;
+        bool busy_polling = w->center.is_busy_polling();
+        auto poll_start = ceph::mono_clock::now();
         int r = w->center.process_events(EventMaxWaitUs, &dur);
         if (r < 0) {
           ldout(cct, 20) << __func__ << " process events failed: "
                          << cpp_strerror(errno) << dendl;
           // TODO do something?
+        } else if (r == 0 && busy_polling) {
+          w->perf_logger->tinc(l_msgr_running_busy_poll_time,
+                               ceph::mono_clock::now() - poll_start);
         }
         w->perf_logger->tinc(l_msgr_running_total_time, dur);
       }
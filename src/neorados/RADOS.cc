@@ -880,6 +880,86 @@ void RADOS::execute(const Object& o, std::int64_t pool, WriteOp&& _op,
     std::move(c), objver);
 }
 
+namespace {
+// shared by the reads of one batch, freed by the last one to complete
+struct BatchState {
+  std::vector<bs::error_code> ecs;
+  std::atomic<std::size_t> left;
+  std::unique_ptr<RADOS::BatchComp> c;
+
+  BatchState(std::size_t n, std::unique_ptr<RADOS::BatchComp> c)
+    : ecs(n), left(n), c(std::move(c)) {}
+
+  void complete(std::size_t i, bs::error_code ec) {
+    ecs[i] = ec;
+    if (--left == 0) {
+      bs::error_code first;
+      for (const auto& e : ecs) {
+	if (e) {
+	  first = e;
+	  break;
+	}
+      }
+      ca::post(std::move(c), first, std::move(ecs));
+      delete this;
+    }
+  }
+};
+
+// Completion for one read of a batch.  It only records the result, so
+// finishing a read costs no handler invocation or executor hop; the
+// batch's own handler is posted once, by the last read.
+class BatchOpComp final : public Op::Completion {
+  BatchState* state;
+  std::size_t i;
+
+  void finish(bs::error_code ec) {
+    auto s = state;
+    auto n = i;
+    this->~BatchOpComp();
+    ::operator delete(static_cast<void*>(this));
+    s->complete(n, ec);
+  }
+
+  void destroy_defer(std::tuple<bs::error_code>&& args) override {
+    finish(std::get<0>(args));
+  }
+  void destroy_dispatch(std::tuple<bs::error_code>&& args) override {
+    finish(std::get<0>(args));
+  }
+  void destroy_post(std::tuple<bs::error_code>&& args) override {
+    finish(std::get<0>(args));
+  }
+  void destroy() override {
+    ::operator delete(static_cast<void*>(this));
+  }
+
+public:
+  BatchOpComp(BatchState* state, std::size_t i)
+    : state(state), i(i) {}
+};
+}
+
+void RADOS::execute(const IOContext& _ioc, std::vector<BatchRead>&& reads,
+		    std::unique_ptr<BatchComp> c) {
+  if (reads.empty()) {
+    ca::post(std::move(c), bs::error_code{},
+	     std::vector<bs::error_code>{});
+    return;
+  }
+  auto ioc = reinterpret_cast<const IOContextImpl*>(&_ioc.impl);
+  auto state = new BatchState(reads.size(), std::move(c));
+  for (std::size_t i = 0; i < reads.size(); ++i) {
+    auto& r = reads[i];
+    auto oid = reinterpret_cast<const object_t*>(&r.obj.impl);
+    auto op = reinterpret_cast<OpImpl*>(&r.op.impl);
+    auto flags = op->op.flags;
+    impl->objecter->read(
+      *oid, ioc->oloc, std::move(op->op), ioc->snap_seq, r.bl, flags,
+      std::unique_ptr<Op::Completion>(new BatchOpComp(state, i)));
+  }
+}
+
 boost::uuids::uuid RADOS::get_fsid() const noexcept {
   return impl->monclient.get_fsid().uuid;
 }
@@ -55,6 +55,45 @@ uint64_t AvlAllocator::_block_picker(const Tree& t,
    return _block_picker(t, cursor, size, align);
 }
 
+/*
+ * Near-fit search over the offset-sorted tree, starting at *cursor.  Unlike
+ * _block_picker() this gives up after max_search_count segments or after
+ * walking max_search_bytes of address space, so a fragmented device cannot
+ * turn a single allocation into a scan of every free segment; the caller
+ * falls back to the size-sorted tree in that case.
+ */
+uint64_t AvlAllocator::_pick_block_after(uint64_t *cursor,
+					 uint64_t size,
+					 uint64_t align)
+{
+  const auto compare = range_tree.key_comp();
+  uint64_t search_count = 0;
+  uint64_t search_bytes = 0;
+  for (int pass = 0; pass < 2; ++pass) {
+    auto rs_start = range_tree.lower_bound(range_t{*cursor, size}, compare);
+    for (auto rs = rs_start; rs != range_tree.end(); ++rs) {
+      uint64_t offset = p2roundup(rs->start, align);
+      if (offset + size <= rs->end) {
+	*cursor = offset + size;
+	return offset;
+      }
+      if (max_search_count > 0 && ++search_count > max_search_count) {
+	return -1ULL;
+      }
+      search_bytes += rs->end - rs->start;
+      if (max_search_bytes > 0 && search_bytes > max_search_bytes) {
+	return -1ULL;
+      }
+    }
+    if (*cursor == 0) {
+      // we have searched the whole tree
+      break;
+    }
+    *cursor = 0;
+  }
+  return -1ULL;
+}
+
 void AvlAllocator::_add_to_tree(uint64_t start, uint64_t size)
 {
   ceph_assert(size != 0);
@@ -242,7 +281,12 @@ int AvlAllocator::_allocate(
     *cursor = 0;
     start = _block_picker(range_size_tree, cursor, size, unit);
   } else {
-    start = _block_picker(range_tree, cursor, size, unit);
+    start = _pick_block_after(cursor, size, unit);
+    if (start == -1ULL) {
+      // near-fit gave up; best-fit is authoritative about ENOSPC
+      uint64_t bf_cursor = 0;
+      start = _block_picker(range_size_tree, &bf_cursor, size, unit);
+    }
   }
   if (start == -1ULL) {
     return -ENOSPC;
@@ -296,6 +340,10 @@ AvlAllocator::AvlAllocator(CephContext* cct,
     cct->_conf.get_val<uint64_t>("bluestore_avl_alloc_bf_threshold")),
   range_size_alloc_free_pct(
     cct->_conf.get_val<uint64_t>("bluestore_avl_alloc_bf_free_pct")),
+  max_search_count(
+    cct->_conf.get_val<uint64_t>("bluestore_avl_alloc_ff_max_search_count")),
+  max_search_bytes(
+    cct->_conf.get_val<Option::size_t>("bluestore_avl_alloc_ff_max_search_bytes")),
   range_count_cap(max_mem / sizeof(range_seg_t)),
   cct(cct)
 {}
@@ -311,6 +359,10 @@ AvlAllocator::AvlAllocator(CephContext* cct,
     cct->_conf.get_val<uint64_t>("bluestore_avl_alloc_bf_threshold")),
   range_size_alloc_free_pct(
     cct->_conf.get_val<uint64_t>("bluestore_avl_alloc_bf_free_pct")),
+  max_search_count(
+    cct->_conf.get_val<uint64_t>("bluestore_avl_alloc_ff_max_search_count")),
+  max_search_bytes(
+    cct->_conf.get_val<Option::size_t>("bluestore_avl_alloc_ff_max_search_bytes")),
   cct(cct)
 {}
 
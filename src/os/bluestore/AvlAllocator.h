@@ -98,6 +98,7 @@ private:
   template<class Tree>
   uint64_t _block_picker(const Tree& t, uint64_t *cursor, uint64_t size,
     uint64_t align);
+  uint64_t _pick_block_after(uint64_t *cursor, uint64_t size, uint64_t align);
   int _allocate(
     uint64_t size,
     uint64_t unit,
@@ -157,6 +158,13 @@ private:
    * switch to using best-fit allocations.
    */
   int range_size_alloc_free_pct = 0;
+  /*
+   * Maximum number of segments to examine, and maximum amount of free
+   * space to walk over, in near-fit mode before giving up and using
+   * best-fit for this allocation.  0 means unlimited.
+   */
+  uint64_t max_search_count = 0;
+  uint64_t max_search_bytes = 0;
 
   /*
   * Max amount of range entries allowed. 0 - unlimited
@@ -332,11 +332,32 @@ void BitmapFreelistManager::enumerate_reset()
   enumerate_p.reset();
 }
 
+// return true if the whole 64-bit word starting at bit 'start' (which
+// must be byte aligned) equals 'pattern'.  this lets the scans below skip
+// fully allocated / fully free regions of a large bitmap quickly.
+static bool word_is(const char *p, int start, int bits, uint64_t pattern)
+{
+  if ((start & 7) || start + 64 > bits) {
+    return false;
+  }
+  uint64_t w;
+  memcpy(&w, p + (start >> 3), sizeof(w));
+  return w == pattern;
+}
+
 int get_next_clear_bit(bufferlist& bl, int start)
 {
   const char *p = bl.c_str();
   int bits = bl.length() << 3;
   while (start < bits) {
+    if (word_is(p, start, bits, ~0ull)) {
+      start += 64;
+      continue;
+    }
+    if ((start & 7) == 0 && (unsigned char)p[start >> 3] == 0xff) {
+      start += 8;
+      continue;
+    }
     // byte = start / 8 (or start >> 3)
     // bit = start % 8 (or start & 7)
     unsigned char byte_mask = 1 << (start & 7);
@@ -353,6 +374,14 @@ int get_next_set_bit(bufferlist& bl, int start)
   const char *p = bl.c_str();
   int bits = bl.length() << 3;
   while (start < bits) {
+    if (word_is(p, start, bits, 0)) {
+      start += 64;
+      continue;
+    }
+    if ((start & 7) == 0 && p[start >> 3] == 0) {
+      start += 8;
+      continue;
+    }
     int which_byte = start / 8;
     int which_bit = start % 8;
     unsigned char byte_mask = 1 << which_bit;
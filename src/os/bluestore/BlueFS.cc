@@ -179,10 +179,14 @@ BlueFS::BlueFS(CephContext* cct)
   discard_cb[BDEV_DB] = db_discard_cb;
   discard_cb[BDEV_SLOW] = slow_discard_cb;
   asok_hook = SocketHook::create(this);
+  read_random_readahead =
+    cct->_conf.get_val<bool>("bluefs_read_random_readahead");
+  cct->_conf.add_observer(this);
 }
 
 BlueFS::~BlueFS()
 {
+  cct->_conf.remove_observer(this);
   delete asok_hook;
   for (auto p : ioc) {
     if (p)
@@ -199,6 +203,23 @@ BlueFS::~BlueFS()
   }
 }
 
+const char **BlueFS::get_tracked_conf_keys() const
+{
+  static const char* KEYS[] = {
+    "bluefs_read_random_readahead",
+    NULL
+  };
+  return KEYS;
+}
+
+void BlueFS::handle_conf_change(const ConfigProxy& conf,
+				const std::set<std::string> &changed)
+{
+  if (changed.count("bluefs_read_random_readahead")) {
+    read_random_readahead = conf.get_val<bool>("bluefs_read_random_readahead");
+  }
+}
+
 void BlueFS::_init_logger()
 {
   PerfCountersBuilder b(cct, "bluefs",
@@ -269,6 +290,9 @@ void BlueFS::_init_logger()
   b.add_u64_counter(l_bluefs_read_random_buffer_bytes, "read_random_buffer_bytes",
 		    "Bytes read from prefetch buffer in random read mode", NULL,
 		    PerfCountersBuilder::PRIO_USEFUL, unit_t(UNIT_BYTES));
+  b.add_u64_counter(l_bluefs_read_random_readahead_count,
+		    "read_random_readahead_count",
+		    "Readahead buffer fills triggered by sequential random reads");
 
   b.add_u64_counter(l_bluefs_read_count, "read_count",
 		    "buffered read requests processed");
@@ -1939,6 +1963,41 @@ void BlueFS::_drop_link(FileRef file)
   }
 }
 
+bool BlueFS::_fill_read_buffer(
+  FileReader *h,
+  uint64_t off,
+  uint64_t len,
+  uint64_t prefetch)
+{
+  FileReaderBuffer *buf = &(h->buf);
+  buf->bl.clear();
+  buf->bl_off = off & super.block_mask();
+  uint64_t x_off = 0;
+  auto p = h->file->fnode.seek(buf->bl_off, &x_off);
+  if (p == h->file->fnode.extents.end()) {
+    return false;
+  }
+
+  uint64_t want = round_up_to(len + (off & ~super.block_mask()),
+			      super.block_size);
+  want = std::max(want, prefetch);
+  uint64_t l = std::min(p->length - x_off, want);
+  //hard cap to 1GB
+  l = std::min(l, uint64_t(1) << 30);
+  uint64_t eof_offset = round_up_to(h->file->fnode.size, super.block_size);
+  if (!h->ignore_eof &&
+      buf->bl_off + l > eof_offset) {
+    l = eof_offset - buf->bl_off;
+  }
+  dout(20) << __func__ << " fetching 0x"
+	   << std::hex << x_off << "~" << l << std::dec
+	   << " of " << *p << dendl;
+  int r = bdev[p->bdev]->read(p->offset + x_off, l, &buf->bl, ioc[p->bdev],
+			      cct->_conf->bluefs_buffered_io);
+  ceph_assert(r == 0);
+  return true;
+}
+
 int64_t BlueFS::_read_random(
   FileReader *h,         ///< [in] read from here
   uint64_t off,          ///< [in] offset
@@ -1966,9 +2025,41 @@ int64_t BlueFS::_read_random(
   logger->inc(l_bluefs_read_random_count, 1);
   logger->inc(l_bluefs_read_random_bytes, len);
 
+  // a run of "random" reads that each start exactly where the previous
+  // one ended is most likely a scan; serve it from a readahead buffer
+  // rather than issuing one small direct IO per block.  A single adjacent
+  // pair (say an index block followed by a filter block) is common outside
+  // of scans, so only prefetch from the second hit in a row on.
+  uint64_t readahead = cct->_conf->bluefs_max_prefetch;
+  bool sequential = false;
+  if (read_random_readahead && len < readahead) {
+    if (h->random_next_off.exchange(off + len) == off) {
+      sequential = ++h->random_seq_hits >= 2;
+    } else {
+      h->random_seq_hits = 0;
+    }
+  }
+
   std::shared_lock s_lock(h->lock);
   buf->bl.reassign_to_mempool(mempool::mempool_bluefs_file_reader);
   while (len > 0) {
+    if (sequential &&
+	(off < buf->bl_off || off >= buf->get_buf_end())) {
+      s_lock.unlock();
+      {
+	std::unique_lock u_lock(h->lock);
+	if (off < buf->bl_off || off >= buf->get_buf_end()) {
+	  if (!_fill_read_buffer(h, off, len, readahead)) {
+	    // let the direct path below deal with it
+	    sequential = false;
+	  } else {
+	    logger->inc(l_bluefs_read_random_readahead_count, 1);
+	  }
+	}
+      }
+      s_lock.lock();
+      continue;
+    }
     if (off < buf->bl_off || off >= buf->get_buf_end()) {
       s_lock.unlock();
       uint64_t x_off = 0;
@@ -2071,33 +2162,11 @@ int64_t BlueFS::_read(
       buf->bl.reassign_to_mempool(mempool::mempool_bluefs_file_reader);
       if (off < buf->bl_off || off >= buf->get_buf_end()) {
         // if precondition hasn't changed during locking upgrade.
-        buf->bl.clear();
-        buf->bl_off = off & super.block_mask();
-        uint64_t x_off = 0;
-        auto p = h->file->fnode.seek(buf->bl_off, &x_off);
-	if (p == h->file->fnode.extents.end()) {
+	if (!_fill_read_buffer(h, off, len, buf->max_prefetch)) {
 	  dout(5) << __func__ << " reading less then required "
 		  << ret << "<" << ret + len << dendl;
 	  break;
 	}
-
-        uint64_t want = round_up_to(len + (off & ~super.block_mask()),
-				    super.block_size);
-        want = std::max(want, buf->max_prefetch);
-        uint64_t l = std::min(p->length - x_off, want);
-        //hard cap to 1GB
-	l = std::min(l, uint64_t(1) << 30);
-        uint64_t eof_offset = round_up_to(h->file->fnode.size, super.block_size);
-        if (!h->ignore_eof &&
-	    buf->bl_off + l > eof_offset) {
-	  l = eof_offset - buf->bl_off;
-        }
-        dout(20) << __func__ << " fetching 0x"
-                 << std::hex << x_off << "~" << l << std::dec
-                 << " of " << *p << dendl;
-        int r = bdev[p->bdev]->read(p->offset + x_off, l, &buf->bl, ioc[p->bdev],
-				    cct->_conf->bluefs_buffered_io);
-        ceph_assert(r == 0);
       }
       u_lock.unlock();
       s_lock.lock();
@@ -2429,6 +2498,19 @@ void BlueFS::_compact_log_async(std::unique_lock<ceph::mutex>& l)
     log_cond.wait(l);
   }
 
+  // make the data written so far stable before we log the jump.  drop the
+  // lock around the device flush, as _flush_bdev_safely does, so that
+  // foreground syncs are not stalled behind it.  new_log is already set, so
+  // no other compaction can start meanwhile, but a log flush can, so wait
+  // for it again.
+  l.unlock();
+  flush_bdev();
+  l.lock();
+  while (log_flushing) {
+    dout(10) << __func__ << " log is currently flushing, waiting" << dendl;
+    log_cond.wait(l);
+  }
+
   vselector->sub_usage(log_file->vselector_hint, log_file->fnode);
 
   // 1. allocate new log space and jump to it.
@@ -2448,8 +2530,6 @@ void BlueFS::_compact_log_async(std::unique_lock<ceph::mutex>& l)
   log_t.op_file_update(log_file->fnode);
   log_t.op_jump(log_seq, old_log_jump_to);
 
-  flush_bdev();  // FIXME?
-
   _flush_and_sync_log(l, 0, old_log_jump_to);
 
   // 2. prepare compacted log
@@ -47,6 +47,7 @@ enum {
   l_bluefs_read_random_disk_bytes,
   l_bluefs_read_random_buffer_count,
   l_bluefs_read_random_buffer_bytes,
+  l_bluefs_read_random_readahead_count,
   l_bluefs_read_count,
   l_bluefs_read_bytes,
   l_bluefs_read_prefetch_count,
@@ -93,7 +94,7 @@ public:
 };
 class BlueFS;
 
-class BlueFS {
+class BlueFS : public md_config_obs_t {
 public:
   CephContext* cct;
   static constexpr unsigned MAX_BDEV = 5;
@@ -254,6 +255,11 @@ public:
     FileReaderBuffer buf;
     bool random;
     bool ignore_eof;        ///< used when reading our log file
+    /// end of the last read_random(), for sequential access detection;
+    /// starts out matching no offset so the first read is not a hit
+    std::atomic<uint64_t> random_next_off = {UINT64_MAX};
+    /// read_random() calls in a row that started where the previous ended
+    std::atomic<unsigned> random_seq_hits = {0};
 
     ceph::shared_mutex lock {
      ceph::make_shared_mutex(std::string(), false, false, false)
@@ -284,6 +290,9 @@ private:
 
   PerfCounters *logger = nullptr;
 
+  /// cached bluefs_read_random_readahead, read on every random read
+  std::atomic<bool> read_random_readahead = {false};
+
   uint64_t max_bytes[MAX_BDEV] = {0};
   uint64_t max_bytes_pcounters[MAX_BDEV] = {
     l_bluefs_max_bytes_wal,
@@ -411,6 +420,13 @@ private:
     uint64_t offset, ///< [in] offset
     uint64_t len,    ///< [in] this many bytes
     char *out);      ///< [out] optional: or copy it here
+  /// (re)load h->buf with at least [off, off+len) plus prefetch bytes;
+  /// h->lock must be held exclusively.  false if off is past the extents.
+  bool _fill_read_buffer(
+    FileReader *h,
+    uint64_t off,
+    uint64_t len,
+    uint64_t prefetch);
 
   void _invalidate_cache(FileRef f, uint64_t offset, uint64_t length);
 
@@ -446,6 +462,11 @@ public:
   BlueFS(CephContext* cct);
   ~BlueFS();
 
+  // config observer
+  const char** get_tracked_conf_keys() const override;
+  void handle_conf_change(const ConfigProxy& conf,
+			  const std::set<std::string> &changed) override;
+
   // the super is always stored on bdev 0
   int mkfs(uuid_d osd_uuid, const bluefs_layout_t& layout);
   int mount();
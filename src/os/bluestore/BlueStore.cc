@@ -19,6 +19,7 @@
 #include <fcntl.h>
 
 #include <boost/container/flat_set.hpp>
+#include <boost/container/small_vector.hpp>
 #include "boost/algorithm/string.hpp"
 
 #include "include/cpp-btree/btree_set.h"
@@ -783,6 +784,12 @@ int64_t BlueStore::GarbageCollector::estimate(
 }
 
 // LruOnodeCacheShard
+//
+// Newly loaded onodes go to a cold list and are only promoted to the hot
+// list when they are used again after bluestore_onode_cache_promote_age.
+// A one-pass scan (scrub, backfill, listing with stat) touches each object
+// in a quick burst and never gets promoted, so it recycles the cold list
+// instead of pushing the working set out.
 struct LruOnodeCacheShard : public BlueStore::OnodeCacheShard {
   typedef boost::intrusive::list<
     BlueStore::Onode,
@@ -791,14 +798,25 @@ struct LruOnodeCacheShard : public BlueStore::OnodeCacheShard {
       boost::intrusive::list_member_hook<>,
       &BlueStore::Onode::lru_item> > list_t;
 
-  list_t lru;
+  list_t lru;       ///< promoted onodes
+  list_t cold_lru;  ///< onodes not reused since they were loaded
+  ceph::timespan promote_age;
 
-  explicit LruOnodeCacheShard(CephContext *cct) : BlueStore::OnodeCacheShard(cct) {}
+  explicit LruOnodeCacheShard(CephContext *cct)
+    : BlueStore::OnodeCacheShard(cct),
+      promote_age(ceph::make_timespan(
+        cct->_conf.get_val<double>("bluestore_onode_cache_promote_age"))) {}
+
+  list_t& _list_of(BlueStore::Onode* o) {
+    return o->cache_cold ? cold_lru : lru;
+  }
 
   void _add(BlueStore::Onode* o, int level) override
   {
+    o->cache_cold = true;
+    o->cache_added = ceph::coarse_mono_clock::now();
     if (o->put_cache()) {
-      (level > 0) ? lru.push_front(*o) : lru.push_back(*o);
+      (level > 0) ? cold_lru.push_front(*o) : cold_lru.push_back(*o);
     } else {
       ++num_pinned;
     }
@@ -808,7 +826,8 @@ struct LruOnodeCacheShard : public BlueStore::OnodeCacheShard {
   void _rm(BlueStore::Onode* o) override
   {
     if (o->pop_cache()) {
-      lru.erase(lru.iterator_to(*o));
+      auto& l = _list_of(o);
+      l.erase(l.iterator_to(*o));
     } else {
       ceph_assert(num_pinned);
       --num_pinned;
@@ -819,39 +838,44 @@ struct LruOnodeCacheShard : public BlueStore::OnodeCacheShard {
   }
   void _pin(BlueStore::Onode* o) override
   {
-    lru.erase(lru.iterator_to(*o));
+    auto& l = _list_of(o);
+    l.erase(l.iterator_to(*o));
     ++num_pinned;
     dout(20) << __func__ << this << " " << " " << " " << o->oid << " pinned" << dendl;
   }
   void _unpin(BlueStore::Onode* o) override
   {
-    lru.push_front(*o);
+    if (o->cache_cold &&
+        ceph::coarse_mono_clock::now() - o->cache_added >= promote_age) {
+      o->cache_cold = false;
+    }
+    _list_of(o).push_front(*o);
     ceph_assert(num_pinned);
     --num_pinned;
-    dout(20) << __func__ << this << " " << " " << " " << o->oid << " unpinned" << dendl;
+    dout(20) << __func__ << this << " " << " " << " " << o->oid << " unpinned"
+             << (o->cache_cold ? " (cold)" : "") << dendl;
   }
 
   void _trim_to(uint64_t new_size) override
   {
-    if (new_size >= lru.size()) {
+    uint64_t size = lru.size() + cold_lru.size();
+    if (new_size >= size) {
       return; // don't even try
-    } 
-    uint64_t n = lru.size() - new_size;
-    auto p = lru.end();
-    ceph_assert(p != lru.begin());
-    --p;
+    }
+    uint64_t n = size - new_size;
     ceph_assert(num >= n);
     num -= n;
+    // keep evicting cold onodes while they take more than 3/8 of the
+    // cache so that hot ones survive a scan, as with midpoint insertion
+    uint64_t cold_min = new_size * 3 / 8;
     while (n-- > 0) {
-      BlueStore::Onode *o = &*p;
+      list_t& l = (cold_lru.size() > cold_min || lru.empty()) ? cold_lru : lru;
+      ceph_assert(!l.empty());
+      BlueStore::Onode *o = &l.back();
       dout(20) << __func__ << "  rm " << o->oid << " "
-               << o->nref << " " << o->cached << " " << o->pinned << dendl;
-      if (p != lru.begin()) {
-        lru.erase(p--);
-      } else {
-        ceph_assert(n == 0);
-        lru.erase(p);
-      }
+               << o->nref << " " << o->cached << " " << o->pinned
+               << (o->cache_cold ? " cold" : "") << dendl;
+      l.pop_back();
       auto pinned = !o->pop_cache();
       ceph_assert(!pinned);
       o->c->onode_map._remove(o->oid);
@@ -1419,6 +1443,7 @@ void BlueStore::BufferSpace::read(
   res_intervals.clear();
   uint32_t want_bytes = length;
   uint32_t end = offset + length;
+  uint64_t ghost_bytes = 0;
 
   {
     std::lock_guard l(cache->lock);
@@ -1469,6 +1494,10 @@ void BlueStore::BufferSpace::read(
 	  offset += b->length;
 	  length -= b->length;
         }
+      } else if (b->is_empty()) {
+	// a ghost entry (e.g. 2Q warm_out): we had this data and evicted it.
+	// these misses are what a bigger (or second tier) cache would absorb.
+	ghost_bytes += std::min(end, b->end()) - std::max(offset, b->offset);
       }
     }
   }
@@ -1478,6 +1507,9 @@ void BlueStore::BufferSpace::read(
   uint64_t miss_bytes = want_bytes - hit_bytes;
   cache->logger->inc(l_bluestore_buffer_hit_bytes, hit_bytes);
   cache->logger->inc(l_bluestore_buffer_miss_bytes, miss_bytes);
+  if (ghost_bytes) {
+    cache->logger->inc(l_bluestore_buffer_ghost_hit_bytes, ghost_bytes);
+  }
 }
 
 void BlueStore::BufferSpace::_finish_write(BufferCacheShard* cache, uint64_t seq)
@@ -2795,10 +2827,15 @@ unsigned BlueStore::ExtentMap::decode_some(bufferlist& bl)
 
   uint32_t num;
   denc_varint(num, p);
-  vector<BlobRef> blobs(num);
+  // most shards only reference a handful of local blobs; keep them on the
+  // stack instead of allocating for every shard we fault in.
+  boost::container::small_vector<BlobRef, 16> blobs(num);
   uint64_t pos = 0;
   uint64_t prev_len = 0;
   unsigned n = 0;
+  // extents are encoded in logical order, so each one lands right after
+  // the previous one; pass that as a hint to avoid a full tree descent.
+  auto hint = extent_map.end();
 
   while (!p.end()) {
     Extent *le = new Extent();
@@ -2845,7 +2882,7 @@ unsigned BlueStore::ExtentMap::decode_some(bufferlist& bl)
     }
     pos += prev_len;
     ++n;
-    extent_map.insert(*le);
+    hint = std::next(extent_map.insert(hint, *le));
   }
 
   ceph_assert(n == num);
@@ -4519,6 +4556,8 @@ void BlueStore::_init_logger()
   b.add_time_avg(l_bluestore_kv_sync_lat, "kv_sync_lat",
 		 "Average kv_sync thread latency",
 		 "ks_l", PerfCountersBuilder::PRIO_INTERESTING);
+  b.add_u64_avg(l_bluestore_kv_sync_txc_batch, "kv_sync_txc_batch",
+		"Average number of transactions committed per kv_sync cycle");
   b.add_time_avg(l_bluestore_kv_final_lat, "kv_final_lat",
 		 "Average kv_finalize thread latency",
 		 "kf_l", PerfCountersBuilder::PRIO_INTERESTING);
@@ -4571,12 +4610,17 @@ void BlueStore::_init_logger()
     "Sum for beneficial compress ops");
   b.add_u64_counter(l_bluestore_compress_rejected_count, "compress_rejected_count",
     "Sum for compress ops rejected due to low net gain of space");
+  b.add_u64_counter(l_bluestore_compress_sample_skipped_count,
+    "compress_sample_skipped_count",
+    "Sum for blobs left uncompressed because a sample did not compress");
   b.add_u64_counter(l_bluestore_write_pad_bytes, "write_pad_bytes",
 		    "Sum for write-op padded bytes", NULL, 0, unit_t(UNIT_BYTES));
   b.add_u64_counter(l_bluestore_deferred_write_ops, "deferred_write_ops",
 		    "Sum for deferred write op");
   b.add_u64_counter(l_bluestore_deferred_write_bytes, "deferred_write_bytes",
 		    "Sum for deferred write bytes", "def", 0, unit_t(UNIT_BYTES));
+  b.add_u64_counter(l_bluestore_deferred_write_merged, "deferred_write_merged",
+		    "Sum for deferred write extents merged into an adjacent write");
   b.add_u64_counter(l_bluestore_write_penalty_read_ops, "write_penalty_read_ops",
 		    "Sum for write penalty read ops");
   b.add_u64(l_bluestore_allocated, "bluestore_allocated",
@@ -4617,6 +4661,10 @@ void BlueStore::_init_logger()
 	    "Sum for bytes of read hit in the cache", NULL, 0, unit_t(UNIT_BYTES));
   b.add_u64_counter(l_bluestore_buffer_miss_bytes, "bluestore_buffer_miss_bytes",
 	    "Sum for bytes of read missed in the cache", NULL, 0, unit_t(UNIT_BYTES));
+  b.add_u64_counter(l_bluestore_buffer_ghost_hit_bytes,
+	    "bluestore_buffer_ghost_hit_bytes",
+	    "Sum for bytes of read missed in the cache but recently evicted from it",
+	    NULL, 0, unit_t(UNIT_BYTES));
 
   b.add_u64_counter(l_bluestore_write_big, "bluestore_write_big",
 		    "Large aligned writes into fresh blobs");
@@ -7982,9 +8030,30 @@ void BlueStore::_fsck_check_objects(FSCKDepth depth,
     CollectionRef c;
     int64_t pool_id = -1;
     spg_t pgid;
+    const double progress_interval =
+      cct->_conf.get_val<double>("bluestore_fsck_progress_interval");
+    const auto scan_start = mono_clock::now();
+    auto last_progress = scan_start;
+    uint64_t scanned = 0;
+    uint64_t deep_read_bytes = 0;
     for (it->lower_bound(string()); it->valid(); it->next()) {
       dout(30) << __func__ << " key "
         << pretty_binary_string(it->key()) << dendl;
+      if (progress_interval > 0 && (++scanned & 0xff) == 0) {
+        auto now = mono_clock::now();
+        if (ceph::to_seconds<double>(now - last_progress) >= progress_interval) {
+          last_progress = now;
+          double elapsed = ceph::to_seconds<double>(now - scan_start);
+          dout(1) << __func__ << " progress: scanned " << scanned << " keys"
+                  << ", " << errors << " errors";
+          if (depth == FSCK_DEEP) {
+            *_dout << ", read " << byte_u_t(deep_read_bytes);
+          }
+          *_dout << " in " << elapsed << "s ("
+                 << (uint64_t)(scanned / elapsed) << " keys/s)"
+                 << dendl;
+        }
+      }
       if (is_extent_shard_key(it->key())) {
         if (depth == FSCK_SHALLOW) {
           continue;
@@ -8181,6 +8250,7 @@ void BlueStore::_fsck_check_objects(FSCKDepth depth,
               break;
             }
             offset += l;
+            deep_read_bytes += l;
           } while (offset < o->onode.size);
         } // deep
       } //if (depth != FSCK_SHALLOW)
@@ -11321,50 +11391,14 @@ void BlueStore::_txc_state_proc(TransContext *txc)
 
     case TransContext::STATE_IO_DONE:
       ceph_assert(ceph_mutex_is_locked(txc->osr->qlock));  // see _txc_finish_io
-      if (txc->had_ios) {
-	++txc->osr->txc_with_unstable_io;
-      }
-      throttle.log_state_latency(*txc, logger, l_bluestore_state_io_done_lat);
-      txc->set_state(TransContext::STATE_KV_QUEUED);
-      if (cct->_conf->bluestore_sync_submit_transaction) {
-	if (txc->last_nid >= nid_max ||
-	    txc->last_blobid >= blobid_max) {
-	  dout(20) << __func__
-		   << " last_{nid,blobid} exceeds max, submit via kv thread"
-		   << dendl;
-	} else if (txc->osr->kv_committing_serially) {
-	  dout(20) << __func__ << " prior txc submitted via kv thread, us too"
-		   << dendl;
-	  // note: this is starvation-prone.  once we have a txc in a busy
-	  // sequencer that is committing serially it is possible to keep
-	  // submitting new transactions fast enough that we get stuck doing
-	  // so.  the alternative is to block here... fixme?
-	} else if (txc->osr->txc_with_unstable_io) {
-	  dout(20) << __func__ << " prior txc(s) with unstable ios "
-		   << txc->osr->txc_with_unstable_io.load() << dendl;
-	} else if (cct->_conf->bluestore_debug_randomize_serial_transaction &&
-		   rand() % cct->_conf->bluestore_debug_randomize_serial_transaction
-		   == 0) {
-	  dout(20) << __func__ << " DEBUG randomly forcing submit via kv thread"
-		   << dendl;
-	} else {
-	  _txc_apply_kv(txc, true);
-	}
-      }
+      _txc_prepare_kv_queue(txc);
       {
 	std::lock_guard l(kv_lock);
-	kv_queue.push_back(txc);
+	_txc_kv_queue_locked(txc);
 	if (!kv_sync_in_progress) {
 	  kv_sync_in_progress = true;
 	  kv_cond.notify_one();
 	}
-	if (txc->get_state() != TransContext::STATE_KV_SUBMITTED) {
-	  kv_queue_unsubmitted.push_back(txc);
-	  ++txc->osr->kv_committing_serially;
-	}
-	if (txc->had_ios)
-	  kv_ios++;
-	kv_throttle_costs += txc->cost;
       }
       return;
     case TransContext::STATE_KV_SUBMITTED:
@@ -11426,16 +11460,83 @@ void BlueStore::_txc_finish_io(TransContext *txc)
       break;
     }
   }
+  // move every txc that is now ready into the kv queue under a single
+  // kv_lock acquisition instead of taking it once per txc.
+  boost::container::small_vector<TransContext*, 16> ready;
   do {
-    _txc_state_proc(&*p++);
+    TransContext *t = &*p++;
+    _txc_prepare_kv_queue(t);
+    ready.push_back(t);
   } while (p != osr->q.end() &&
 	   p->get_state() == TransContext::STATE_IO_DONE);
+  {
+    std::lock_guard kl(kv_lock);
+    for (auto t : ready) {
+      _txc_kv_queue_locked(t);
+    }
+    if (!kv_sync_in_progress) {
+      kv_sync_in_progress = true;
+      kv_cond.notify_one();
+    }
+  }
 
   if (osr->kv_submitted_waiters) {
     osr->qcond.notify_all();
   }
 }
 
+void BlueStore::_txc_prepare_kv_queue(TransContext *txc)
+{
+  ceph_assert(txc->get_state() == TransContext::STATE_IO_DONE);
+  if (txc->had_ios) {
+    ++txc->osr->txc_with_unstable_io;
+  }
+  throttle.log_state_latency(*txc, logger, l_bluestore_state_io_done_lat);
+  txc->set_state(TransContext::STATE_KV_QUEUED);
+  if (cct->_conf->bluestore_sync_submit_transaction) {
+    if (txc->last_nid >= nid_max ||
+	txc->last_blobid >= blobid_max) {
+      dout(20) << __func__
+	       << " last_{nid,blobid} exceeds max, submit via kv thread"
+	       << dendl;
+    } else if (txc->osr->kv_committing_serially) {
+      dout(20) << __func__ << " prior txc submitted via kv thread, us too"
+	       << dendl;
+      // note: this is starvation-prone.  once we have a txc in a busy
+      // sequencer that is committing serially it is possible to keep
+      // submitting new transactions fast enough that we get stuck doing
+      // so.  the alternative is to block here... fixme?
+    } else if (txc->osr->txc_with_unstable_io) {
+      dout(20) << __func__ << " prior txc(s) with unstable ios "
+	       << txc->osr->txc_with_unstable_io.load() << dendl;
+    } else if (cct->_conf->bluestore_debug_randomize_serial_transaction &&
+	       rand() % cct->_conf->bluestore_debug_randomize_serial_transaction
+	       == 0) {
+      dout(20) << __func__ << " DEBUG randomly forcing submit via kv thread"
+	       << dendl;
+    } else {
+      _txc_apply_kv(txc, true);
+    }
+  }
+  // count it now, not when it is queued: the next txc of a batch in
+  // _txc_finish_io must see it, or it could be submitted ahead of us
+  if (txc->get_state() != TransContext::STATE_KV_SUBMITTED) {
+    ++txc->osr->kv_committing_serially;
+  }
+}
+
+void BlueStore::_txc_kv_queue_locked(TransContext *txc)
+{
+  ceph_assert(ceph_mutex_is_locked(kv_lock));
+  kv_queue.push_back(txc);
+  if (txc->get_state() != TransContext::STATE_KV_SUBMITTED) {
+    kv_queue_unsubmitted.push_back(txc);
+  }
+  if (txc->had_ios)
+    kv_ios++;
+  kv_throttle_costs += txc->cost;
+}
+
 void BlueStore::_txc_write_nodes(TransContext *txc, KeyValueDB::Transaction t)
 {
   dout(20) << __func__ << " txc " << txc
@@ -12087,6 +12188,7 @@ void BlueStore::_kv_sync_thread()
 
       int committing_size = kv_committing.size();
       int deferred_size = deferred_stable.size();
+      logger->inc(l_bluestore_kv_sync_txc_batch, committing_size);
 
 #if defined(WITH_LTTNG)
       double sync_latency = ceph::to_seconds<double>(mono_clock::now() - sync_start);
@@ -12314,12 +12416,23 @@ void BlueStore::deferred_try_submit()
   dout(20) << __func__ << " " << deferred_queue.size() << " osrs, "
 	   << deferred_queue_size << " txcs" << dendl;
   std::lock_guard l(deferred_lock);
-  vector<OpSequencerRef> osrs;
+  vector<std::pair<uint64_t,OpSequencerRef>> osrs;
   osrs.reserve(deferred_queue.size());
   for (auto& osr : deferred_queue) {
-    osrs.push_back(&osr);
-  }
-  for (auto& osr : osrs) {
+    uint64_t first = 0;
+    if (osr.deferred_pending && !osr.deferred_pending->iomap.empty()) {
+      first = osr.deferred_pending->iomap.begin()->first;
+    }
+    osrs.emplace_back(first, &osr);
+  }
+  // issue the batches of all sequencers in ascending device offset order
+  // so that (on HDDs in particular) the disk sweeps across them once
+  // instead of seeking back and forth between PGs.
+  std::stable_sort(osrs.begin(), osrs.end(),
+		   [](const auto& a, const auto& b) {
+		     return a.first < b.first;
+		   });
+  for (auto& [first, osr] : osrs) {
     if (osr->deferred_pending) {
       if (!osr->deferred_running) {
 	_deferred_submit_unlock(osr.get());
@@ -12357,6 +12470,7 @@ void BlueStore::_deferred_submit_unlock(OpSequencer *osr)
     throttle.log_state_latency(txc, logger, l_bluestore_state_deferred_queued_lat);
   }
   uint64_t start = 0, pos = 0;
+  uint64_t writes = 0;
   bufferlist bl;
   auto i = b->iomap.begin();
   while (true) {
@@ -12365,6 +12479,7 @@ void BlueStore::_deferred_submit_unlock(OpSequencer *osr)
 	dout(20) << __func__ << " write 0x" << std::hex
 		 << start << "~" << bl.length()
 		 << " crc " << bl.crc32c(-1) << std::dec << dendl;
+	++writes;
 	if (!g_conf()->bluestore_debug_omit_block_device_write) {
 	  logger->inc(l_bluestore_deferred_write_ops);
 	  logger->inc(l_bluestore_deferred_write_bytes, bl.length());
@@ -12389,6 +12504,8 @@ void BlueStore::_deferred_submit_unlock(OpSequencer *osr)
     bl.claim_append(i->second.bl);
     ++i;
   }
+  ceph_assert(writes <= b->iomap.size());
+  logger->inc(l_bluestore_deferred_write_merged, b->iomap.size() - writes);
 
   bdev->aio_submit(&b->ioc);
 }
@@ -13827,6 +13944,8 @@ int BlueStore::_do_alloc_write(
   // compress (as needed) and calc needed space
   uint64_t need = 0;
   auto max_bsize = std::max(wctx->target_blob_size, min_alloc_size);
+  uint64_t sample_size = c ?
+    cct->_conf.get_val<Option::size_t>("bluestore_compression_sample_size") : 0;
   for (auto& wi : wctx->writes) {
     if (c && wi.blob_length > min_alloc_size) {
       auto start = mono_clock::now();
@@ -13835,6 +13954,29 @@ int BlueStore::_do_alloc_write(
       ceph_assert(wi.b_off == 0);
       ceph_assert(wi.blob_length == wi.bl.length());
 
+      if (sample_size && wi.blob_length >= sample_size * 4) {
+	// probe the head of the blob first and skip compressing the whole
+	// thing if the sample does not shrink at all
+	bufferlist sample, st;
+	sample.substr_of(wi.bl, 0, sample_size);
+	boost::optional<int32_t> sample_message;
+	int r = c->compress(sample, st, sample_message);
+	if (r != 0 || st.length() >= sample_size) {
+	  dout(20) << __func__ << std::hex << "  0x" << wi.blob_length
+		   << " sample 0x" << sample_size << " compressed to 0x"
+		   << st.length() << " with " << c->get_type()
+		   << ", leaving uncompressed"
+		   << std::dec << dendl;
+	  logger->inc(l_bluestore_compress_sample_skipped_count);
+	  need += wi.blob_length;
+	  log_latency("compress@_do_alloc_write",
+	    l_bluestore_compress_lat,
+	    mono_clock::now() - start,
+	    cct->_conf->bluestore_log_op_age );
+	  continue;
+	}
+      }
+
       // FIXME: memory alignment here is bad
       bufferlist t;
       boost::optional<int32_t> compressor_message;
@@ -74,6 +74,7 @@ enum {
   l_bluestore_kv_flush_lat,
   l_bluestore_kv_commit_lat,
   l_bluestore_kv_sync_lat,
+  l_bluestore_kv_sync_txc_batch,
   l_bluestore_kv_final_lat,
   l_bluestore_state_prepare_lat,
   l_bluestore_state_aio_wait_lat,
@@ -97,9 +98,11 @@ enum {
   l_bluestore_csum_lat,
   l_bluestore_compress_success_count,
   l_bluestore_compress_rejected_count,
+  l_bluestore_compress_sample_skipped_count,
   l_bluestore_write_pad_bytes,
   l_bluestore_deferred_write_ops,
   l_bluestore_deferred_write_bytes,
+  l_bluestore_deferred_write_merged,
   l_bluestore_write_penalty_read_ops,
   l_bluestore_allocated,
   l_bluestore_stored,
@@ -118,6 +121,7 @@ enum {
   l_bluestore_buffer_bytes,
   l_bluestore_buffer_hit_bytes,
   l_bluestore_buffer_miss_bytes,
+  l_bluestore_buffer_ghost_hit_bytes,
   l_bluestore_write_big,
   l_bluestore_write_big_bytes,
   l_bluestore_write_big_blobs,
@@ -1075,6 +1079,8 @@ public:
                               /// of it at the moment though)
     bool pinned;              ///< Onode is pinned
                               /// (or should be pinned when cached)
+    bool cache_cold = true;   ///< Onode has not been promoted in the cache yet
+    ceph::coarse_mono_time cache_added; ///< when the Onode entered the cache
     ExtentMap extent_map;
 
     // track txc's that have not been committed to kv store (and whose
@@ -2424,6 +2430,8 @@ public:
   }
 private:
   void _txc_finish_io(TransContext *txc);
+  void _txc_prepare_kv_queue(TransContext *txc);
+  void _txc_kv_queue_locked(TransContext *txc);
   void _txc_finalize_kv(TransContext *txc, KeyValueDB::Transaction t);
   void _txc_apply_kv(TransContext *txc, bool sync_submit_transaction);
   void _txc_committed_kv(TransContext *txc);
@@ -2755,6 +2763,10 @@ private:
     std::vector<ceph::buffer::list>* compressed_blob_bls,
     IOContext* ioc);
 
+  /// assemble the result of a read into @p bl.  data read from the device
+  /// and cached buffers are referenced, never copied, so the result can be
+  /// handed to the messenger as is; only holes get freshly zeroed memory,
+  /// since callers may modify the returned buffers in place.
   int _generate_read_result_bl(
     OnodeRef o,
     uint64_t offset,
@@ -96,8 +96,23 @@ int64_t ZonedAllocator::allocate(
   return want_size;
 }
 
+// Released space is not reusable until its zone is reset, so we only account
+// it as dead bytes in the zone, mirroring ZonedFreelistManager::release.
 void ZonedAllocator::release(const interval_set<uint64_t>& release_set) {
   std::lock_guard l(lock);
+  for (auto p = release_set.begin(); p != release_set.end(); ++p) {
+    uint64_t offset = p.get_start();
+    uint64_t length = p.get_len();
+    while (length) {
+      uint64_t zone_num = offset / zone_size;
+      uint64_t l = std::min(length, zone_size - offset % zone_size);
+      ldout(cct, 10) << __func__ << " 0x" << std::hex << offset << "~" << l
+		     << " in zone 0x" << zone_num << std::dec << dendl;
+      zone_states[zone_num].increment_num_dead_bytes(l);
+      offset += l;
+      length -= l;
+    }
+  }
 }
 
 uint64_t ZonedAllocator::get_free() {
@@ -107,6 +122,13 @@ uint64_t ZonedAllocator::get_free() {
 
 void ZonedAllocator::dump() {
   std::lock_guard l(lock);
+  for (uint64_t zone_num = 0; zone_num < zone_states.size(); ++zone_num) {
+    if (get_write_pointer(zone_num) == 0) {
+      continue;
+    }
+    ldout(cct, 0) << __func__ << " zone 0x" << std::hex << zone_num
+		  << " " << zone_states[zone_num] << std::dec << dendl;
+  }
 }
 
 void ZonedAllocator::dump(std::function<void(uint64_t offset,
@@ -159,6 +181,12 @@ void ZonedAllocator::set_zone_states(std::vector<zone_state_t> &&_zone_states) {
   zone_states = std::move(_zone_states);
 }
 
+zone_state_t ZonedAllocator::get_zone_state(uint64_t zone_num) {
+  std::lock_guard l(lock);
+  ceph_assert(zone_num < zone_states.size());
+  return zone_states[zone_num];
+}
+
 void ZonedAllocator::shutdown() {
   ldout(cct, 1) << __func__ << dendl;
 }
@@ -76,6 +76,7 @@ public:
                                uint64_t length)> notify) override;
 
   void set_zone_states(std::vector<zone_state_t> &&_zone_states) override;
+  zone_state_t get_zone_state(uint64_t zone_num);
   void init_add_free(uint64_t offset, uint64_t length) override;
   void init_rm_free(uint64_t offset, uint64_t length) override;
 
@@ -934,7 +934,7 @@ void FileJournal::queue_completions_thru(uint64_t seq)
     if (next.finish)
       finisher->queue(next.finish);
     if (next.tracked_op) {
-      next.tracked_op->mark_event("journaled_completion_queued");
+      next.tracked_op->mark_event_static("journaled_completion_queued");
       next.tracked_op->journal_trace.event("queued completion");
       next.tracked_op->journal_trace.keyval("completed through", seq);
     }
@@ -983,7 +983,7 @@ int FileJournal::prepare_single_write(write_item &next_write, bufferlist& bl, of
 
   bl.claim_append(ebl);
   if (next_write.tracked_op) {
-    next_write.tracked_op->mark_event("write_thread_in_journal_buffer");
+    next_write.tracked_op->mark_event_static("write_thread_in_journal_buffer");
     next_write.tracked_op->journal_trace.event("prepare_single_write");
   }
 
@@ -1628,7 +1628,7 @@ void FileJournal::submit_entry(uint64_t seq, bufferlist& e, uint32_t orig_len,
   }
 
   if (osd_op) {
-    osd_op->mark_event("commit_queued_for_journal_write");
+    osd_op->mark_event_static("commit_queued_for_journal_write");
     if (osd_op->store_trace) {
       osd_op->journal_trace.init("journal", &trace_endpoint, &osd_op->store_trace);
       osd_op->journal_trace.event("submit_entry");
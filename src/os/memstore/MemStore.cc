@@ -1497,17 +1497,19 @@ int BufferlistObject::write(uint64_t offset, const ceph::buffer::list &src)
 
   std::lock_guard<decltype(mutex)> lock(mutex);
 
-  // before
-  ceph::buffer::list newdata;
-  if (get_size() >= offset) {
-    newdata.substr_of(data, 0, offset);
-  } else {
-    if (get_size()) {
-      newdata.substr_of(data, 0, get_size());
+  // appends don't need the existing data rebuilt
+  if (offset >= get_size()) {
+    if (offset > get_size()) {
+      data.append_zero(offset - get_size());
     }
-    newdata.append_zero(offset - get_size());
+    data.append(src);
+    return 0;
   }
 
+  // before
+  ceph::buffer::list newdata;
+  newdata.substr_of(data, 0, offset);
+
   newdata.append(src);
 
   // after
@@ -895,7 +895,7 @@ struct SubWriteCommitted : public Context {
       version(version), last_complete(last_complete), trace(trace) {}
   void finish(int) override {
     if (msg)
-      msg->mark_event("sub_op_committed");
+      msg->mark_event_static("sub_op_committed");
     pg->sub_write_committed(tid, version, last_complete, trace);
   }
 };
@@ -938,7 +938,7 @@ void ECBackend::handle_sub_write(
   const ZTracer::Trace &trace)
 {
   if (msg)
-    msg->mark_event("sub_op_started");
+    msg->mark_event_static("sub_op_started");
   trace.event("handle_sub_write");
   if (!get_parent()->pgb_is_primary())
     get_parent()->update_stats(op.stats);
@@ -1035,22 +1035,36 @@ void ECBackend::handle_sub_read(
         dout(25) << __func__ << " case2: going to do fragmented read." << dendl;
         int subchunk_size =
           sinfo.get_chunk_size() / ec_impl->get_sub_chunk_count();
-        bool error = false;
-        for (int m = 0; m < (int)j->get<1>() && !error;
+        // gather every sub-chunk range of every chunk into one vectored
+        // read so the store can look up the object and issue the io once
+        interval_set<uint64_t> extents;
+        for (int m = 0; m < (int)j->get<1>();
              m += sinfo.get_chunk_size()) {
           for (auto &&k:op.subchunks.find(i->first)->second) {
-            bufferlist bl0;
-            r = store->read(
+            extents.insert(
+                j->get<0>() + m + (k.first)*subchunk_size,
+                (k.second)*subchunk_size);
+          }
+        }
+        // recovery reads come in whole recovery chunks and may run past
+        // the end of the shard, but readv wants every extent inside it
+        struct stat st;
+        r = store->stat(
+            ch,
+            ghobject_t(i->first, ghobject_t::NO_GEN, shard),
+            &st);
+        if (r == 0) {
+          interval_set<uint64_t> in_object;
+          if (st.st_size > 0) {
+            in_object.insert(0, st.st_size);
+          }
+          extents.intersection_of(in_object);
+          if (!extents.empty()) {
+            r = store->readv(
                 ch,
                 ghobject_t(i->first, ghobject_t::NO_GEN, shard),
-                j->get<0>() + m + (k.first)*subchunk_size,
-                (k.second)*subchunk_size,
-                bl0, j->get<2>());
-            if (r < 0) {
-              error = true;
-              break;
-            }
-            bl.claim_append(bl0);
+                extents,
+                bl, j->get<2>());
           }
         }
       }
@@ -2042,12 +2056,17 @@ bool ECBackend::try_reads_to_commit()
   op->remote_read.clear();
   op->remote_read_result.clear();
 
-  ObjectStore::Transaction empty;
   bool should_write_local = false;
   ECSubWrite local_write_op;
   std::vector<std::pair<int, Message*>> messages;
   messages.reserve(get_parent()->get_acting_recovery_backfill_shards().size());
   set<pg_shard_t> backfill_shards = get_parent()->get_backfill_shards();
+  // a backfill target may share a shard id with an acting osd; only the
+  // last user of each shard transaction can take it instead of copying
+  map<shard_id_t, unsigned> trans_users;
+  for (auto &i : get_parent()->get_acting_recovery_backfill_shards()) {
+    ++trans_users[i.shard];
+  }
   for (set<pg_shard_t>::const_iterator i =
 	 get_parent()->get_acting_recovery_backfill_shards().begin();
        i != get_parent()->get_acting_recovery_backfill_shards().end();
@@ -2063,13 +2082,20 @@ bool ECBackend::try_reads_to_commit()
       get_info().stats :
       parent->get_shard_info().find(*i)->second.stats;
 
+    ObjectStore::Transaction shard_t;
+    if (--trans_users[i->shard] == 0) {
+      if (should_send)
+	shard_t = std::move(iter->second);
+    } else if (should_send) {
+      shard_t = iter->second;
+    }
     ECSubWrite sop(
       get_parent()->whoami_shard(),
       op->tid,
       op->reqid,
       op->hoid,
       stats,
-      should_send ? iter->second : empty,
+      std::move(shard_t),
       op->version,
       op->trim_to,
       op->roll_forward_to,
@@ -2194,6 +2220,17 @@ void ECBackend::objects_read_async(
   map<hobject_t,std::list<boost::tuple<uint64_t, uint64_t, uint32_t> > >
     reads;
 
+  // a lone read that falls inside one data chunk only needs the shard
+  // holding that chunk; decide on the caller's extent, since the stripe
+  // rounding below always widens it to every data chunk
+  map<hobject_t, int> single_chunks;
+  if (to_read.size() == 1) {
+    int single_chunk = get_single_chunk_index(
+      to_read.front().first.get<0>(), to_read.front().first.get<1>());
+    if (single_chunk >= 0)
+      single_chunks[hoid] = single_chunk;
+  }
+
   uint32_t flags = 0;
   extent_set es;
   for (list<pair<boost::tuple<uint64_t, uint64_t, uint32_t>,
@@ -2300,7 +2337,8 @@ void ECBackend::objects_read_async(
 	cb(this,
 	   hoid,
 	   to_read,
-	   on_complete)));
+	   on_complete)),
+    single_chunks);
 }
 
 struct CallClientContexts :
@@ -2309,12 +2347,42 @@ struct CallClientContexts :
   ECBackend *ec;
   ECBackend::ClientAsyncReadStatus *status;
   list<boost::tuple<uint64_t, uint64_t, uint32_t> > to_read;
+  int single_chunk;  ///< data chunk index of a single chunk read, or -1
   CallClientContexts(
     hobject_t hoid,
     ECBackend *ec,
     ECBackend::ClientAsyncReadStatus *status,
-    const list<boost::tuple<uint64_t, uint64_t, uint32_t> > &to_read)
-    : hoid(hoid), ec(ec), status(status), to_read(to_read) {}
+    const list<boost::tuple<uint64_t, uint64_t, uint32_t> > &to_read,
+    int single_chunk = -1)
+    : hoid(hoid), ec(ec), status(status), to_read(to_read),
+      single_chunk(single_chunk) {}
+  /// hand back the wanted chunk of the stripe at stripe_off, mapped to its
+  /// logical offset; the caller trims it to the extent it asked for
+  int finish_single_chunk(
+    ECBackend::read_result_t &res,
+    uint64_t stripe_off,
+    extent_map *result) {
+    int shard = ec->ec_impl->get_chunk_mapping().size() > (unsigned)single_chunk ?
+      ec->ec_impl->get_chunk_mapping()[single_chunk] : single_chunk;
+    map<int, bufferlist> to_decode;
+    for (auto &&j : res.returned.front().get<2>()) {
+      to_decode[j.first.shard] = std::move(j.second);
+    }
+    bufferlist chunk;
+    auto p = to_decode.find(shard);
+    if (p != to_decode.end()) {
+      chunk = std::move(p->second);
+    } else {
+      // the shard was not readable; rebuild just that chunk
+      map<int, bufferlist*> out = {{shard, &chunk}};
+      int r = ECUtil::decode(ec->sinfo, ec->ec_impl, to_decode, out);
+      if (r < 0)
+	return r;
+    }
+    uint64_t chunk_off = stripe_off + single_chunk * ec->sinfo.get_chunk_size();
+    result->insert(chunk_off, chunk.length(), std::move(chunk));
+    return 0;
+  }
   void finish(pair<RecoveryMessages *, ECBackend::read_result_t &> &in) override {
     ECBackend::read_result_t &res = in.second;
     extent_map result;
@@ -2328,6 +2396,15 @@ struct CallClientContexts :
 	  make_pair(read.get<0>(), read.get<1>()));
       ceph_assert(res.returned.front().get<0>() == adjusted.first &&
 	     res.returned.front().get<1>() == adjusted.second);
+      if (single_chunk >= 0) {
+	int r = finish_single_chunk(res, adjusted.first, &result);
+	if (r < 0) {
+	  res.r = r;
+	  goto out;
+	}
+	res.returned.pop_front();
+	continue;
+      }
       map<int, bufferlist> to_decode;
       bufferlist bl;
       for (map<pg_shard_t, bufferlist>::iterator j =
@@ -2366,7 +2443,8 @@ void ECBackend::objects_read_and_reconstruct(
     std::list<boost::tuple<uint64_t, uint64_t, uint32_t> >
   > &reads,
   bool fast_read,
-  GenContextURef<map<hobject_t,pair<int, extent_map> > &&> &&func)
+  GenContextURef<map<hobject_t,pair<int, extent_map> > &&> &&func,
+  const map<hobject_t, int> &single_chunks)
 {
   in_progress_client_reads.emplace_back(
     reads.size(), std::move(func));
@@ -2381,10 +2459,24 @@ void ECBackend::objects_read_and_reconstruct(
     
   map<hobject_t, read_request_t> for_read_op;
   for (auto &&to_read: reads) {
+    auto sc = single_chunks.find(to_read.first);
+    int single_chunk = sc != single_chunks.end() ? sc->second : -1;
+    set<int> want_single;
+    if (single_chunk >= 0) {
+      ceph_assert(to_read.second.size() == 1);
+      ceph_assert(to_read.second.front().get<1>() == sinfo.get_stripe_width());
+      const vector<int> &chunk_mapping = ec_impl->get_chunk_mapping();
+      want_single.insert((int)chunk_mapping.size() > single_chunk ?
+			 chunk_mapping[single_chunk] : single_chunk);
+      dout(20) << __func__ << " " << to_read.first << " reads only chunk "
+	       << single_chunk << dendl;
+    }
+    const set<int> &want = single_chunk >= 0 ? want_single : want_to_read;
+
     map<pg_shard_t, vector<pair<int, int>>> shards;
     int r = get_min_avail_to_read_shards(
       to_read.first,
-      want_to_read,
+      want,
       false,
       fast_read,
       &shards);
@@ -2394,7 +2486,8 @@ void ECBackend::objects_read_and_reconstruct(
       to_read.first,
       this,
       &(in_progress_client_reads.back()),
-      to_read.second);
+      to_read.second,
+      single_chunk);
     for_read_op.insert(
       make_pair(
 	to_read.first,
@@ -2403,7 +2496,7 @@ void ECBackend::objects_read_and_reconstruct(
 	  shards,
 	  false,
 	  c)));
-    obj_want_to_read.insert(make_pair(to_read.first, want_to_read));
+    obj_want_to_read.insert(make_pair(to_read.first, want));
   }
 
   start_read_op(
@@ -2416,6 +2509,17 @@ void ECBackend::objects_read_and_reconstruct(
 }
 
 
+int ECBackend::get_single_chunk_index(uint64_t off, uint64_t len) const
+{
+  if (len == 0)
+    return -1;
+  uint64_t chunk_size = sinfo.get_chunk_size();
+  uint64_t in_stripe = off % sinfo.get_stripe_width();
+  if (in_stripe % chunk_size + len > chunk_size)
+    return -1;
+  return in_stripe / chunk_size;
+}
+
 int ECBackend::send_all_remaining_reads(
   const hobject_t &hoid,
   ReadOp &rop)
@@ -2543,7 +2647,7 @@ int ECBackend::be_deep_scrub(
     pos.data_hash << bl;
   }
   pos.data_pos += r;
-  if (r == (int)stride) {
+  if (r == (int)stride && (uint64_t)pos.data_pos < o.size) {
     return -EINPROGRESS;
   }
 
@@ -140,7 +140,8 @@ public:
     const std::map<hobject_t, std::list<boost::tuple<uint64_t, uint64_t, uint32_t> >
     > &reads,
     bool fast_read,
-    GenContextURef<std::map<hobject_t,std::pair<int, extent_map> > &&> &&func);
+    GenContextURef<std::map<hobject_t,std::pair<int, extent_map> > &&> &&func,
+    const std::map<hobject_t, int> &single_chunks = {});
 
   friend struct CallClientContexts;
   struct ClientAsyncReadStatus {
@@ -208,6 +209,9 @@ private:
 			sinfo.get_stripe_width());
   }
 
+  /// data chunk index if [off, off+len) lies within one chunk, else -1
+  int get_single_chunk_index(uint64_t off, uint64_t len) const;
+
   void get_want_to_read_shards(std::set<int> *want_to_read) const {
     const std::vector<int> &chunk_mapping = ec_impl->get_chunk_mapping();
     for (int i = 0; i < (int)ec_impl->get_data_chunk_count(); ++i) {
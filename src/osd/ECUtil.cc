@@ -136,17 +136,65 @@ int ECUtil::encode(
   if (logical_size == 0)
     return 0;
 
-  for (uint64_t i = 0; i < logical_size; i += sinfo.get_stripe_width()) {
+  // same alignment ErasureCode::encode_prepare() gives each chunk
+  const unsigned simd_align = 32;
+  const uint64_t chunk_size = sinfo.get_chunk_size();
+  const unsigned k = ec_impl->get_data_chunk_count();
+  const unsigned n = ec_impl->get_chunk_count();
+  const vector<int> &mapping = ec_impl->get_chunk_mapping();
+  auto chunk_index = [&](unsigned i) {
+    return mapping.size() > i ? mapping[i] : (int)i;
+  };
+
+  if (!ec_impl->can_encode_chunks_in_place() || chunk_size % simd_align) {
+    for (uint64_t i = 0; i < logical_size; i += sinfo.get_stripe_width()) {
+      map<int, bufferlist> encoded;
+      bufferlist buf;
+      buf.substr_of(in, i, sinfo.get_stripe_width());
+      int r = ec_impl->encode(want, buf, &encoded);
+      ceph_assert(r == 0);
+      for (map<int, bufferlist>::iterator i = encoded.begin();
+	   i != encoded.end();
+	   ++i) {
+	ceph_assert(i->second.length() == sinfo.get_chunk_size());
+	(*out)[i->first].claim_append(i->second);
+      }
+    }
+  } else {
+    // allocate each coding chunk once for all stripes, and have the plugin
+    // encode every stripe in place into its slice
+    uint64_t shard_size = logical_size / sinfo.get_stripe_width() * chunk_size;
+    map<int, bufferptr> coding;
+    for (unsigned i = k; i < n; ++i) {
+      coding[chunk_index(i)] = buffer::create_aligned(shard_size, CEPH_PAGE_SIZE);
+    }
     map<int, bufferlist> encoded;
-    bufferlist buf;
-    buf.substr_of(in, i, sinfo.get_stripe_width());
-    int r = ec_impl->encode(want, buf, &encoded);
-    ceph_assert(r == 0);
-    for (map<int, bufferlist>::iterator i = encoded.begin();
-	 i != encoded.end();
-	 ++i) {
-      ceph_assert(i->second.length() == sinfo.get_chunk_size());
-      (*out)[i->first].claim_append(i->second);
+    uint64_t shard_off = 0;
+    for (uint64_t i = 0; i < logical_size;
+	 i += sinfo.get_stripe_width(), shard_off += chunk_size) {
+      for (unsigned j = 0; j < k; ++j) {
+	bufferlist &chunk = encoded[chunk_index(j)];
+	chunk.clear();
+	chunk.substr_of(in, i + j * chunk_size, chunk_size);
+	chunk.rebuild_aligned_size_and_memory(chunk_size, simd_align);
+	ceph_assert(chunk.is_contiguous());
+      }
+      for (auto &c : coding) {
+	bufferlist &chunk = encoded[c.first];
+	chunk.clear();
+	chunk.append(c.second, shard_off, chunk_size);
+      }
+      int r = ec_impl->encode_chunks(want, &encoded);
+      ceph_assert(r == 0);
+      for (unsigned j = 0; j < k; ++j) {
+	int shard = chunk_index(j);
+	if (want.count(shard))
+	  (*out)[shard].claim_append(encoded[shard]);
+      }
+    }
+    for (auto &c : coding) {
+      if (want.count(c.first))
+	(*out)[c.first].append(std::move(c.second));
     }
   }
 
@@ -133,6 +133,7 @@
 
 #include "common/perf_counters.h"
 #include "common/Timer.h"
+#include "common/Thread.h"
 #include "common/LogClient.h"
 #include "common/AsyncReserver.h"
 #include "common/HeartbeatMap.h"
@@ -4670,7 +4671,7 @@ void OSD::load_pgs()
     derr << "failed to list pgs: " << cpp_strerror(-r) << dendl;
   }
 
-  int num = 0;
+  vector<pair<PGRef, coll_t>> to_load;
   for (vector<coll_t>::iterator it = ls.begin();
        it != ls.end();
        ++it) {
@@ -4723,20 +4724,48 @@ void OSD::load_pgs()
       recursive_remove_collection(cct, store, pgid, *it);
       continue;
     }
+    to_load.emplace_back(pg, *it);
+  }
+
+  // reading the info and log is most of the work, and each pg only
+  // touches its own collection, so spread that over one thread per op
+  // shard
+  {
+    std::atomic<size_t> next{0};
+    auto read_pgs = [&] {
+      for (size_t i = next++; i < to_load.size(); i = next++) {
+	PGRef& pg = to_load[i].first;
+	pg->lock();
+	pg->ch = store->open_collection(pg->coll);
+	pg->read_disk_state(store);
+	pg->unlock();
+      }
+    };
+    size_t num_threads = std::min(shards.size(), to_load.size());
+    vector<std::thread> readers;
+    for (size_t i = 1; i < num_threads; ++i) {
+      readers.push_back(make_named_thread("load_pgs", read_pgs));
+    }
+    read_pgs();
+    for (auto& t : readers) {
+      t.join();
+    }
+  }
+
+  int num = 0;
+  for (auto& [pg, coll] : to_load) {
+    spg_t pgid = pg->get_pgid();
 
     // there can be no waiters here, so we don't call _wake_pg_slot
 
     pg->lock();
-    pg->ch = store->open_collection(pg->coll);
-
-    // read pg state, log
-    pg->read_state(store);
+    pg->init_read_state(store);
 
     if (pg->dne())  {
-      dout(10) << "load_pgs " << *it << " deleting dne" << dendl;
+      dout(10) << "load_pgs " << coll << " deleting dne" << dendl;
       pg->ch = nullptr;
       pg->unlock();
-      recursive_remove_collection(cct, store, pgid, *it);
+      recursive_remove_collection(cct, store, pgid, coll);
       continue;
     }
     {
@@ -5907,6 +5936,7 @@ void OSD::tick_without_osd_lock()
       sched_scrub();
     }
     service.promote_throttle_recalibrate();
+    autotune_client_throttle();
     resume_creating_pg();
     bool need_send_beacon = false;
     const auto now = ceph::coarse_mono_clock::now();
@@ -5930,6 +5960,67 @@ void OSD::tick_without_osd_lock()
 					      new C_Tick_WithoutOSDLock(this));
 }
 
+void OSD::autotune_client_throttle()
+{
+  auto lat = logger->get_tavg_ns(l_osd_op_before_dequeue_op_lat);
+  Messenger::Policy pol =
+    client_messenger->get_policy(entity_name_t::TYPE_CLIENT);
+  Throttle *throttle = pol.throttler_bytes;
+  int64_t cap = cct->_conf->osd_client_message_size_cap;
+  if (!throttle || cap <= 0) {
+    last_dequeue_op_lat = lat;
+    return;
+  }
+  if (!cct->_conf.get_val<bool>("osd_client_message_size_cap_autotune")) {
+    last_dequeue_op_lat = lat;
+    // undo any earlier tuning once it is switched off
+    if (throttle->get_max() != cap) {
+      throttle->reset_max(cap);
+    }
+    return;
+  }
+  int64_t cur = throttle->get_max();
+  int64_t want = autotune_client_byte_cap(
+    lat, &last_dequeue_op_lat, cap, cur, throttle->get_current(),
+    cct->_conf.get_val<double>(
+      "osd_client_message_size_cap_autotune_target_latency"));
+  if (want != cur) {
+    dout(10) << __func__ << " client byte cap " << cur << " -> " << want
+	     << dendl;
+    throttle->reset_max(want);
+  }
+}
+
+int64_t OSD::autotune_client_byte_cap(
+  std::pair<uint64_t, uint64_t> lat,
+  std::pair<uint64_t, uint64_t> *last,
+  int64_t cap, int64_t cur, int64_t in_use,
+  double target)
+{
+  // get_tavg_ns() returns (count, sum)
+  uint64_t count = lat.first - last->first;
+  uint64_t sum = lat.second - last->second;
+  *last = lat;
+  if (!count) {
+    return cur;
+  }
+
+  // tune between 1/16 of the configured cap and the cap itself: shrink
+  // by 1/8 while ops wait longer than the target before being dequeued,
+  // and grow back while they wait less than half of it and the throttle
+  // is the limit
+  int64_t floor = std::max<int64_t>(cap / 16, 1);
+  double avg = (double)sum / count / 1000000000.0;
+  int64_t want = cur;
+  if (avg > target) {
+    want = std::max(cur - cur / 8, floor);
+  } else if (avg < target / 2 &&
+	     in_use >= cur - cur / 4) {
+    want = std::min(cur + std::max<int64_t>(cap / 16, 1), cap);
+  }
+  return std::clamp(want, floor, cap);
+}
+
 // Usage:
 //   setomapval <pool-id> [namespace/]<obj-name> <key> <val>
 //   rmomapkey <pool-id> [namespace/]<obj-name> <key>
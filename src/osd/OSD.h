@@ -1118,6 +1118,26 @@ protected:
   PerfCounters* create_recoverystate_perf();
   void tick();
   void tick_without_osd_lock();
+  // client byte throttle autotuning, driven from tick_without_osd_lock
+  std::pair<uint64_t, uint64_t> last_dequeue_op_lat{0, 0};
+  void autotune_client_throttle();
+  /**
+   * work out the next client byte cap
+   *
+   * @param lat (count, sum ns) of the dequeue latency, as get_tavg_ns()
+   *            returns it
+   * @param last the previous sample of lat, updated to lat
+   * @param cap the configured osd_client_message_size_cap
+   * @param cur the current throttle max
+   * @param in_use the bytes currently taken from the throttle
+   * @param target the target latency in seconds
+   * @return the new throttle max, cur if there is nothing to change
+   */
+  static int64_t autotune_client_byte_cap(
+    std::pair<uint64_t, uint64_t> lat,
+    std::pair<uint64_t, uint64_t> *last,
+    int64_t cap, int64_t cur, int64_t in_use,
+    double target);
   void _dispatch(Message *m);
   void dispatch_op(OpRequestRef op);
 
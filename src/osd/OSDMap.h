@@ -459,6 +459,25 @@ public:
       return new_erasure_code_profiles;
     }
 
+    /// true if applying this may change any pg's up or acting set
+    bool may_change_pg_mapping() const {
+      return fullmap.length() ||
+	crush.length() ||
+	new_max_osd >= 0 ||
+	!new_pools.empty() ||
+	!old_pools.empty() ||
+	!new_up_client.empty() ||
+	!new_state.empty() ||
+	!new_weight.empty() ||
+	!new_pg_temp.empty() ||
+	!new_primary_temp.empty() ||
+	!new_primary_affinity.empty() ||
+	!new_pg_upmap.empty() ||
+	!old_pg_upmap.empty() ||
+	!new_pg_upmap_items.empty() ||
+	!old_pg_upmap_items.empty();
+    }
+
     /// propagate update pools' snap metadata to any of their tiers
     int propagate_snaps_to_tiers(CephContext *cct, const OSDMap &base);
 
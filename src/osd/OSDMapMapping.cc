@@ -54,6 +54,13 @@ void OSDMapMapping::update(const OSDMap& osdmap)
   //_dump();  // for debugging
 }
 
+void OSDMapMapping::update_epoch(const OSDMap& osdmap)
+{
+  ceph_assert(osdmap.get_epoch() >= epoch);
+  ceph_assert(pools.size() == osdmap.get_pools().size());
+  epoch = osdmap.get_epoch();
+}
+
 void OSDMapMapping::update(const OSDMap& osdmap, pg_t pgid)
 {
   _update_range(osdmap, pgid.pool(), pgid.ps(), pgid.ps() + 1);
@@ -335,6 +335,10 @@ public:
     return job;
   }
 
+  /// advance to @p map without recomputing anything.  only valid if nothing
+  /// that affects pg mappings changed since the epoch we last mapped.
+  void update_epoch(const OSDMap& map);
+
   epoch_t get_epoch() const {
     return epoch;
   }
@@ -71,7 +71,7 @@ void OpRequest::_dump(Formatter *f) const
 
     for (auto i = events.begin(); i != events.end(); ++i) {
       f->open_object_section("event");
-      f->dump_string("event", i->str);
+      f->dump_string("event", i->name());
       f->dump_stream("time") << i->stamp;
 
       auto i_next = i + 1;
@@ -120,7 +120,7 @@ void OpRequest::mark_flag_point(uint8_t flag, const char *s) {
 #ifdef WITH_LTTNG
   uint8_t old_flags = hit_flag_points;
 #endif
-  mark_event(s);
+  mark_event_static(s);
   hit_flag_points |= flag;
   latest_flag_point = flag;
   tracepoint(oprequest, mark_flag_point, reqid.name._type,
@@ -149,6 +149,7 @@ public:
   typedef boost::intrusive_ptr<OpRequest> Ref;
 
 private:
+  /// s must be a string literal
   void mark_flag_point(uint8_t flag, const char *s);
   void mark_flag_point_string(uint8_t flag, const std::string& s);
 };
@@ -1130,7 +1130,7 @@ int PG::read_info(
   return 0;
 }
 
-void PG::read_state(ObjectStore *store)
+void PG::read_disk_state(ObjectStore *store)
 {
   PastIntervals past_intervals_from_disk;
   pg_info_t info_from_disk;
@@ -1167,7 +1167,10 @@ void PG::read_state(ObjectStore *store)
 	osd->clog->error() << oss.str();
       return 0;
     });
+}
 
+void PG::init_read_state(ObjectStore *store)
+{
   if (info_struct_v < pg_latest_struct_v) {
     upgrade(store);
   }
@@ -334,7 +334,14 @@ public:
     ObjectStore::Transaction &t);
 
   /// read existing pg state off disk
-  void read_state(ObjectStore *store);
+  void read_state(ObjectStore *store) {
+    read_disk_state(store);
+    init_read_state(store);
+  }
+  /// read the pg info and log; touches nothing shared with other pgs
+  void read_disk_state(ObjectStore *store);
+  /// set up the mapping and peering state from what read_disk_state() read
+  void init_read_state(ObjectStore *store);
   static int peek_map_epoch(ObjectStore *store, spg_t pgid, epoch_t *pepoch);
 
   static int get_latest_struct_v() {
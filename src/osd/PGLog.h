@@ -384,6 +384,7 @@ public:
 	extra_caller_ops.clear();
       if (to_index & PGLOG_INDEXED_DUPS) {
 	dup_index.clear();
+	dup_index.reserve(dups.size());
 	for (auto& i : dups) {
 	  dup_index[i.reqid] = const_cast<pg_log_dup_t*>(&i);
 	}
@@ -11087,12 +11087,28 @@ ObjectContextRef PrimaryLogPG::get_object_context(
     dout(10) << __func__ << ": obc NOT found in cache: " << soid << dendl;
     // check disk
     bufferlist bv;
+    map<string, bufferlist> all_attrs;
+    int r = 0;
+    if (!attrs && pool.info.is_erasure()) {
+      // ec pools keep every attr in attr_cache, and heads need the snapset
+      // too; fetch them all with a single lookup instead of three.
+      r = pgbackend->objects_get_attrs(soid, &all_attrs);
+      if (r >= 0) {
+	if (all_attrs.count(OI_ATTR)) {
+	  attrs = &all_attrs;
+	} else {
+	  r = -ENODATA;
+	}
+      }
+    }
     if (attrs) {
       auto it_oi = attrs->find(OI_ATTR);
       ceph_assert(it_oi != attrs->end());
       bv = it_oi->second;
     } else {
-      int r = pgbackend->objects_get_attr(soid, OI_ATTR, &bv);
+      if (r == 0) {
+	r = pgbackend->objects_get_attr(soid, OI_ATTR, &bv);
+      }
       if (r < 0) {
 	if (!can_create) {
 	  dout(10) << __func__ << ": no obc for soid "
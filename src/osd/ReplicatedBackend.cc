@@ -556,7 +556,7 @@ void ReplicatedBackend::op_commit(const ceph::ref_t<InProgressOp>& op)
   OID_EVENT_TRACE_WITH_MSG((op && op->op) ? op->op->get_req() : NULL, "OP_COMMIT_BEGIN", true);
   dout(10) << __func__ << ": " << op->tid << dendl;
   if (op->op) {
-    op->op->mark_event("op_commit");
+    op->op->mark_event_static("op_commit");
     op->op->pg_trace.event("op commit");
   }
 
@@ -605,7 +605,7 @@ void ReplicatedBackend::do_repop_reply(OpRequestRef op)
       ceph_assert(ip_op.waiting_for_commit.count(from));
       ip_op.waiting_for_commit.erase(from);
       if (ip_op.op) {
-	ip_op.op->mark_event("sub_op_commit_rec");
+	ip_op.op->mark_event_static("sub_op_commit_rec");
 	ip_op.op->pg_trace.event("sub_op_commit_rec");
       }
     } else {
@@ -668,7 +668,11 @@ int ReplicatedBackend::be_deep_scrub(
       pos.data_hash << bl;
     }
     pos.data_pos += r;
-    if (r == cct->_conf->osd_deep_scrub_stride) {
+    // stop once we reach the size stat() reported, rather than issuing
+    // one more read only to get 0 bytes back when the object size is a
+    // multiple of the stride
+    if (r == cct->_conf->osd_deep_scrub_stride &&
+	(uint64_t)pos.data_pos < o.size) {
       dout(20) << __func__ << "  " << poid << " more data, digest so far 0x"
 	       << std::hex << pos.data_hash.digest() << std::dec << dendl;
       return -EINPROGRESS;
@@ -941,6 +945,7 @@ Message * ReplicatedBackend::generate_subop(
   const bufferlist &log_entries,
   std::optional<pg_hit_set_history_t> &hset_hist,
   ObjectStore::Transaction &op_t,
+  bufferlist &op_t_bl,
   pg_shard_t peer,
   const pg_info_t &pinfo)
 {
@@ -959,7 +964,10 @@ Message * ReplicatedBackend::generate_subop(
     ObjectStore::Transaction t;
     encode(t, wr->get_data());
   } else {
-    encode(op_t, wr->get_data());
+    // encode once and share the buffers between all replicas
+    if (op_t_bl.length() == 0)
+      encode(op_t, op_t_bl);
+    wr->get_data() = op_t_bl;
     wr->get_header().data_off = op_t.get_data_alignment();
   }
 
@@ -1013,6 +1021,7 @@ void ReplicatedBackend::issue_op(
     // avoid doing the same work in generate_subop
     bufferlist logs;
     encode(log_entries, logs);
+    bufferlist op_t_bl;
 
     for (const auto& shard : get_parent()->get_acting_recovery_backfill_shards()) {
       if (shard == parent->whoami_shard()) continue;
@@ -1031,6 +1040,7 @@ void ReplicatedBackend::issue_op(
 	  logs,
 	  hset_hist,
 	  op_t,
+	  op_t_bl,
 	  shard,
 	  pinfo);
       if (op->op && op->op->pg_trace)
@@ -1977,7 +1987,8 @@ void ReplicatedBackend::send_pushes(int prio, map<pg_shard_t, vector<PushOp> > &
 		 << " to osd." << i->first << dendl;
 	cost += j->cost(cct);
 	pushes += 1;
-	msg->pushes.push_back(*j);
+	// callers drop the map afterwards; don't copy the attrs and omap
+	msg->pushes.push_back(std::move(*j));
       }
       msg->set_cost(cost);
       get_parent()->send_message_osd_cluster(msg, con);
@@ -259,7 +259,7 @@ public:
     osd->watch_lock.unlock();
     pg->lock();
     watch->cb = nullptr;
-    if (!watch->is_discarded() && !canceled)
+    if (!watch->is_discarded() && !canceled && !watch->rearm_for_ping())
       watch->pg->handle_watch_timeout(watch);
     delete this; // ~Watch requires pg lock!
     pg->unlock();
@@ -326,25 +326,45 @@ Context *Watch::get_delayed_cb()
 {
   ceph_assert(!cb);
   cb = new HandleDelayedWatchTimeout(self.lock());
+  cb_is_ping_timeout = false;
   return cb;
 }
 
-void Watch::register_cb()
+void Watch::register_cb(double delay)
 {
+  if (delay <= 0)
+    delay = timeout;
   std::lock_guard l(osd->watch_lock);
   if (cb) {
-    dout(15) << "re-registering callback, timeout: " << timeout << dendl;
+    dout(15) << "re-registering callback, timeout: " << delay << dendl;
     cb->cancel();
     osd->watch_timer.cancel_event(cb);
   } else {
-    dout(15) << "registering callback, timeout: " << timeout << dendl;
+    dout(15) << "registering callback, timeout: " << delay << dendl;
   }
   cb = new HandleWatchTimeout(self.lock());
-  if (!osd->watch_timer.add_event_after(timeout, cb)) {
+  cb_is_ping_timeout = will_ping && is_connected();
+  if (!osd->watch_timer.add_event_after(delay, cb)) {
     cb = nullptr;
+    cb_is_ping_timeout = false;
   }
 }
 
+bool Watch::rearm_for_ping()
+{
+  ceph_assert(pg->is_locked());
+  if (!cb_is_ping_timeout || !will_ping || !is_connected())
+    return false;
+  utime_t expire = last_ping;
+  expire += timeout;
+  utime_t now = ceph_clock_now();
+  if (expire <= now)
+    return false;
+  dout(15) << __func__ << " pinged at " << last_ping << dendl;
+  register_cb(expire - now);
+  return true;
+}
+
 void Watch::unregister_cb()
 {
   dout(15) << "unregister_cb" << dendl;
@@ -357,12 +377,15 @@ void Watch::unregister_cb()
     osd->watch_timer.cancel_event(cb); // harmless if not registered with timer
   }
   cb = nullptr;
+  cb_is_ping_timeout = false;
 }
 
 void Watch::got_ping(utime_t t)
 {
   last_ping = t;
-  if (is_connected()) {
+  // a pending ping timeout re-arms itself from last_ping when it fires,
+  // which saves a cancel and an insert into watch_timer on every ping
+  if (is_connected() && !(cb && cb_is_ping_timeout)) {
     register_cb();
   }
 }
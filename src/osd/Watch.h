@@ -150,6 +150,7 @@ class Watch {
   friend class HandleDelayedWatchTimeout;
   ConnectionRef conn;
   CancelableContext *cb;
+  bool cb_is_ping_timeout = false; ///< cb fires timeout after last_ping
 
   OSDService *osd;
   boost::intrusive_ptr<PrimaryLogPG> pg;
@@ -175,7 +176,10 @@ class Watch {
     const entity_addr_t& addr);
 
   /// Registers the timeout callback with watch_timer
-  void register_cb();
+  void register_cb(double delay = 0);
+
+  /// re-arm cb if a ping arrived since it was scheduled
+  bool rearm_for_ping();
 
   /// send a Notify message when connected for notif
   void send_notify(NotifyRef notif);
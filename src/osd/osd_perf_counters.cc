@@ -33,6 +33,9 @@ PerfCounters *build_osd_logger(CephContext *cct) {
   osd_plb.add_u64(
     l_osd_op_wip, "op_wip",
     "Replication operations currently being processed (primary)");
+
+  // the client op counters are bumped by every op shard thread
+  osd_plb.set_sharded_default(true);
   osd_plb.add_u64_counter(
     l_osd_op, "op",
     "Client operations",
@@ -116,6 +119,7 @@ PerfCounters *build_osd_logger(CephContext *cct) {
   osd_plb.add_time_avg(
     l_osd_op_rw_prepare_lat, "op_rw_prepare_latency",
     "Latency of read-modify-write operations (excluding queue time and wait for finished)");
+  osd_plb.set_sharded_default(false);
 
   // Now we move on to some more obscure stats, revert to assuming things
   // are low priority unless otherwise specified.
@@ -4627,10 +4627,17 @@ string pg_log_entry_t::get_key_name() const
 void pg_log_entry_t::encode_with_checksum(ceph::buffer::list& bl) const
 {
   using ceph::encode;
-  ceph::buffer::list ebl(sizeof(*this)*2);
-  this->encode(ebl);
+  // same layout as encoding the entry into a separate bufferlist and then
+  // encoding that (length + payload), but without the extra buffer
+  auto len_filler = bl.append_hole(sizeof(ceph_le32));
+  auto start_offset = bl.length();
+  this->encode(bl);
+  ceph::buffer::list ebl;
+  ebl.substr_of(bl, start_offset, bl.length() - start_offset);
+  ceph_le32 len_le;
+  len_le = ebl.length();
+  len_filler.copy_in(sizeof(len_le), (char*)&len_le);
   __u32 crc = ebl.crc32c(0);
-  encode(ebl, bl);
   encode(crc, bl);
 }
 
@@ -15,6 +15,7 @@
 
 #include <memory>
 #include <functional>
+#include <limits>
 
 #include "osd/scheduler/mClockScheduler.h"
 #include "common/dout.h"
@@ -35,11 +36,45 @@ mClockScheduler::mClockScheduler(CephContext *cct) :
     std::bind(&mClockScheduler::ClientRegistry::get_info,
 	      &client_registry,
 	      _1),
+    cct->_conf.get_val<std::chrono::seconds>(
+      "osd_mclock_scheduler_client_idle_age"),
+    std::max(
+      cct->_conf.get_val<std::chrono::seconds>(
+	"osd_mclock_scheduler_client_idle_age"),
+      cct->_conf.get_val<std::chrono::seconds>(
+	"osd_mclock_scheduler_client_erase_age")),
+    cct->_conf.get_val<std::chrono::seconds>(
+      "osd_mclock_scheduler_client_check_time"),
     dmc::AtLimit::Allow,
     cct->_conf.get_val<double>("osd_mclock_scheduler_anticipation_timeout"))
 {
   cct->_conf.add_observer(this);
   client_registry.update_from_config(cct->_conf);
+  update_cost_from_config(cct->_conf);
+}
+
+void mClockScheduler::update_cost_from_config(const ConfigProxy &conf)
+{
+  auto iops = conf.get_val<double>("osd_mclock_max_capacity_iops");
+  auto bw = conf.get_val<Option::size_t>("osd_mclock_max_sequential_bandwidth");
+  if (iops > 0 && bw > 0) {
+    cost_per_byte.store(iops / bw, std::memory_order_relaxed);
+  } else {
+    cost_per_byte.store(0, std::memory_order_relaxed);
+  }
+}
+
+unsigned mClockScheduler::calc_cost(const OpSchedulerItem &item) const
+{
+  // an op costs one io, plus the time its payload takes to transfer
+  // expressed in ios, so reservations and limits stay in iops
+  double per_byte = cost_per_byte.load(std::memory_order_relaxed);
+  if (per_byte == 0) {
+    return 1;
+  }
+  double cost = 1.0 + std::max(item.get_cost(), 0) * per_byte;
+  return static_cast<unsigned>(
+    std::min<double>(cost, std::numeric_limits<uint32_t>::max()));
 }
 
 void mClockScheduler::ClientRegistry::update_from_config(const ConfigProxy &conf)
@@ -93,8 +128,7 @@ void mClockScheduler::dump(ceph::Formatter &f) const
 void mClockScheduler::enqueue(OpSchedulerItem&& item)
 {
   auto id = get_scheduler_id(item);
-  // TODO: express cost, mclock params in terms of per-node capacity?
-  auto cost = 1; //std::max(item.get_cost(), 1);
+  auto cost = calc_cost(item);
 
   // TODO: move this check into OpSchedulerItem, handle backwards compat
   if (op_scheduler_class::immediate == item.get_scheduler_class()) {
@@ -151,6 +185,8 @@ const char** mClockScheduler::get_tracked_conf_keys() const
     "osd_mclock_scheduler_background_best_effort_res",
     "osd_mclock_scheduler_background_best_effort_wgt",
     "osd_mclock_scheduler_background_best_effort_lim",
+    "osd_mclock_max_capacity_iops",
+    "osd_mclock_max_sequential_bandwidth",
     NULL
   };
   return KEYS;
@@ -161,6 +197,7 @@ void mClockScheduler::handle_conf_change(
   const std::set<std::string> &changed)
 {
   client_registry.update_from_config(conf);
+  update_cost_from_config(conf);
 }
 
 }
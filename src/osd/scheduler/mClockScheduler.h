@@ -15,6 +15,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <ostream>
 #include <map>
 #include <vector>
@@ -90,6 +91,12 @@ class mClockScheduler : public OpScheduler, md_config_obs_t {
   mclock_queue_t scheduler;
   std::list<OpSchedulerItem> immediate;
 
+  /// cost of one byte in units of a small random io, 0 if not configured;
+  /// written by the config observer while ops are being enqueued
+  std::atomic<double> cost_per_byte = 0;
+  void update_cost_from_config(const ConfigProxy &conf);
+  unsigned calc_cost(const OpSchedulerItem &item) const;
+
   static scheduler_id_t get_scheduler_id(const OpSchedulerItem &item) {
     return scheduler_id_t{
       item.get_scheduler_class(),
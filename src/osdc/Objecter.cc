@@ -247,6 +247,8 @@ void Objecter::init()
     pcb.add_u64(l_osdc_op_active, "op_active", "Operations active", "actv",
 		PerfCountersBuilder::PRIO_CRITICAL);
     pcb.add_u64(l_osdc_op_laggy, "op_laggy", "Laggy operations");
+    // bumped for every op by every submitting and dispatching thread
+    pcb.set_sharded_default(true);
     pcb.add_u64_counter(l_osdc_op_send, "op_send", "Sent operations");
     pcb.add_u64_counter(l_osdc_op_send_bytes, "op_send_bytes", "Sent data", NULL, 0, unit_t(UNIT_BYTES));
     pcb.add_u64_counter(l_osdc_op_resend, "op_resend", "Resent operations");
@@ -306,6 +308,7 @@ void Objecter::init()
     pcb.add_u64_counter(l_osdc_osdop_pgls, "osdop_pgls");
     pcb.add_u64_counter(l_osdc_osdop_pgls_filter, "osdop_pgls_filter");
     pcb.add_u64_counter(l_osdc_osdop_other, "osdop_other", "Other operations");
+    pcb.set_sharded_default(false);
 
     pcb.add_u64(l_osdc_linger_active, "linger_active",
 		"Active lingering operations");
@@ -2761,9 +2764,10 @@ int Objecter::_calc_target(op_target_t *t, Connection *con, bool any_change)
   pg_mapping_t pg_mapping;
   pg_mapping.epoch = osdmap->get_epoch();
   if (lookup_pg_mapping(actual_pgid, &pg_mapping)) {
-    up = pg_mapping.up;
+    // pg_mapping is our own copy of the cached entry
+    up = std::move(pg_mapping.up);
     up_primary = pg_mapping.up_primary;
-    acting = pg_mapping.acting;
+    acting = std::move(pg_mapping.acting);
     acting_primary = pg_mapping.acting_primary;
   } else {
     osdmap->pg_to_up_acting_osds(actual_pgid, &up, &up_primary,
@@ -2860,6 +2864,13 @@ int Objecter::_calc_target(op_target_t *t, Connection *con, bool any_change)
       ceph_assert(is_read && acting[0] == acting_primary);
       if (t->flags & CEPH_OSD_FLAG_BALANCE_READS) {
 	int p = rand() % acting.size();
+	if (cct->_conf->objecter_balance_reads_by_latency) {
+	  // power of two choices: keep the random spread, but avoid the
+	  // slower of two candidates
+	  int q = (p + 1 + rand() % (acting.size() - 1)) % acting.size();
+	  p = pick_by_read_lat(p, _get_read_lat_avg(acting[p]),
+			       q, _get_read_lat_avg(acting[q]));
+	}
 	if (p)
 	  t->used_replica = true;
 	osd = acting[p];
@@ -2906,6 +2917,24 @@ int Objecter::_calc_target(op_target_t *t, Connection *con, bool any_change)
   return RECALC_OP_TARGET_NO_ACTION;
 }
 
+uint64_t Objecter::_get_read_lat_avg(int osd)
+{
+  // rwlock is locked
+  auto p = osd_sessions.find(osd);
+  if (p == osd_sessions.end())
+    return 0;
+  return p->second->read_lat_avg_ns.load(std::memory_order_relaxed);
+}
+
+void Objecter::_update_read_lat_avg(OSDSession *s, ceph::timespan lat)
+{
+  uint64_t sample = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    lat).count();
+  s->read_lat_avg_ns.store(
+    fold_read_lat(s->read_lat_avg_ns.load(std::memory_order_relaxed), sample),
+    std::memory_order_relaxed);
+}
+
 int Objecter::_map_session(op_target_t *target, OSDSession **s,
 			   shunique_lock<ceph::shared_mutex>& sul)
 {
@@ -3101,6 +3130,7 @@ Objecter::MOSDOp *Objecter::_prepare_osd_op(Op *op)
 
   op->target.paused = false;
   op->stamp = ceph::coarse_mono_clock::now();
+  op->sent_stamp = ceph::mono_clock::now();
 
   hobject_t hobj = op->target.get_hobj();
   auto m = new MOSDOp(client_inc, op->tid,
@@ -3379,6 +3409,12 @@ void Objecter::handle_osd_op_reply(MOSDOpReply *m)
     return;
   }
 
+  if (rc >= 0 && !(op->target.flags & CEPH_OSD_FLAG_WRITE)) {
+    // coarse_mono_clock ticks in milliseconds, too coarse for a latency
+    // sample; sent_stamp is reset on resend like stamp
+    _update_read_lat_avg(s, ceph::mono_clock::now() - op->sent_stamp);
+  }
+
   sul.unlock();
 
   if (op->objver)
@@ -1665,8 +1665,8 @@ private:
     pg_mapping_t() {}
     pg_mapping_t(epoch_t epoch, std::vector<int> up, int up_primary,
                  std::vector<int> acting, int acting_primary)
-               : epoch(epoch), up(up), up_primary(up_primary),
-                 acting(acting), acting_primary(acting_primary) {}
+               : epoch(epoch), up(std::move(up)), up_primary(up_primary),
+                 acting(std::move(acting)), acting_primary(acting_primary) {}
   };
   ceph::shared_mutex pg_mapping_lock =
     ceph::make_shared_mutex("Objecter::pg_mapping_lock");
@@ -1921,6 +1921,9 @@ public:
     epoch_t *reply_epoch = nullptr;
 
     ceph::coarse_mono_time stamp;
+    /// fine-grained send time for read latency sampling; like stamp, it
+    /// is reset on every resend, so a sample covers the last attempt only
+    ceph::mono_time sent_stamp;
 
     epoch_t map_dne_bound = 0;
 
@@ -2382,6 +2385,8 @@ public:
     int incarnation;
     ConnectionRef con;
     int num_locks;
+    /// moving average of read latency to this osd, in ns (0 if unknown)
+    std::atomic<uint64_t> read_lat_avg_ns = {0};
     std::unique_ptr<std::mutex[]> completion_locks;
 
     OSDSession(CephContext *cct, int o) :
@@ -2400,6 +2405,17 @@ public:
   bool osdmap_full_flag() const;
   bool osdmap_pool_full(const int64_t pool_id) const;
 
+  /// of two balanced-read candidates, the one with the lower read latency
+  /// average; an osd without samples (0) wins, so it gets probed
+  static int pick_by_read_lat(int p, uint64_t p_lat, int q, uint64_t q_lat) {
+    return q_lat < p_lat ? q : p;
+  }
+  /// fold a read latency sample into a moving average, both in ns
+  static uint64_t fold_read_lat(uint64_t avg, uint64_t sample) {
+    // weight new samples 1/8, like a tcp srtt estimate
+    return avg ? avg - avg / 8 + sample / 8 : sample;
+  }
+
 
  private:
 
@@ -2469,6 +2485,8 @@ public:
 		   bool any_change = false);
   int _map_session(op_target_t *op, OSDSession **s,
 		   ceph::shunique_lock<ceph::shared_mutex>& lc);
+  uint64_t _get_read_lat_avg(int osd);
+  void _update_read_lat_avg(OSDSession *s, ceph::timespan lat);
 
   void _session_op_assign(OSDSession *s, Op *op);
   void _session_op_remove(OSDSession *s, Op *op);
@@ -198,6 +198,18 @@ void Striper::file_to_extents(
   if (stripe_count == 1) {
     ldout(cct, 20) << " sc is one, reset su to os" << dendl;
     su = object_size;
+
+    // common case: an unstriped range that stays within one object
+    uint64_t x_offset = offset % object_size;
+    if (object_extents->empty() && x_offset + len <= object_size) {
+      uint64_t objectno = offset / object_size;
+      auto& ex = object_extents->emplace_back(
+        objectno, x_offset, len,
+        object_truncate_size(cct, layout, objectno, trunc_size));
+      ex.buffer_extents.emplace_back(buffer_offset, len);
+      ldout(cct, 15) << "file_to_extents  " << ex << dendl;
+      return;
+    }
   }
   uint64_t stripes_per_object = object_size / su;
   ldout(cct, 20) << " su " << su << " sc " << stripe_count << " os "
@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "common/armor.h"
+#include "common/lru_map.h"
 #include "common/utf8.h"
 #include "rgw_rest_s3.h"
 #include "rgw_auth_s3.h"
@@ -726,12 +727,33 @@ transform_secret_key(const std::string_view& secret_access_key)
 
 /*
  * calculate the SigningKey of AWS auth version 4
+ *
+ * The key only changes with the secret and the day, region and service
+ * of the credential scope, so the last few are kept around instead of
+ * running four HMAC rounds for every request. The secret is part of the
+ * cache key, so rotating it never returns a stale signing key.
  */
+static constexpr int V4_SIGNING_KEY_CACHE_SIZE = 1024;
+
 static sha256_digest_t
 get_v4_signing_key(CephContext* const cct,
                    const std::string_view& credential_scope,
                    const std::string_view& secret_access_key)
 {
+  static lru_map<std::string, sha256_digest_t> signing_keys(
+    V4_SIGNING_KEY_CACHE_SIZE);
+
+  std::string cache_key;
+  cache_key.reserve(secret_access_key.size() + 1 + credential_scope.size());
+  cache_key.append(secret_access_key);
+  cache_key.push_back('\0');
+  cache_key.append(credential_scope);
+
+  sha256_digest_t signing_key;
+  if (signing_keys.find(cache_key, signing_key)) {
+    return signing_key;
+  }
+
   std::string_view date, region, service;
   std::tie(date, region, service) = parse_cred_scope(credential_scope);
 
@@ -741,14 +763,14 @@ get_v4_signing_key(CephContext* const cct,
   const auto service_k = calc_hmac_sha256(region_k, service);
 
   /* aws4_request */
-  const auto signing_key = calc_hmac_sha256(service_k,
-                                            std::string_view("aws4_request"));
+  signing_key = calc_hmac_sha256(service_k, std::string_view("aws4_request"));
 
   ldout(cct, 10) << "date_k    = " << date_k << dendl;
   ldout(cct, 10) << "region_k  = " << region_k << dendl;
   ldout(cct, 10) << "service_k = " << service_k << dendl;
   ldout(cct, 10) << "signing_k = " << signing_key << dendl;
 
+  signing_keys.add(cache_key, signing_key);
   return signing_key;
 }
 
@@ -262,10 +262,9 @@ void ObjectCache::touch_lru(const string& name, ObjectCacheEntry& entry,
     ldout(cct, 10) << "adding " << name << " to cache LRU end" << dendl;
   } else {
     ldout(cct, 10) << "moving " << name << " to cache LRU end" << dendl;
-    lru.erase(lru_iter);
-    lru.push_back(name);
-    lru_iter = lru.end();
-    --lru_iter;
+    // relink the node in place; lru_iter stays valid and the name is
+    // neither copied nor reallocated
+    lru.splice(lru.end(), lru, lru_iter);
   }
 
   lru_counter++;
@@ -1231,6 +1231,7 @@ class RGWRunBucketSourcesSyncCR : public RGWCoroutine {
   int num_shards{0};
   int cur_shard{0};
   bool again = false;
+  const int spawn_window;
 
 public:
   RGWRunBucketSourcesSyncCR(RGWDataSyncCtx *_sc,
@@ -1369,7 +1370,6 @@ public:
   }
 };
 
-#define BUCKET_SHARD_SYNC_SPAWN_WINDOW 20
 #define DATA_SYNC_MAX_ERR_ENTRIES 10
 
 class RGWDataSyncShardCR : public RGWCoroutine {
@@ -1407,7 +1407,7 @@ class RGWDataSyncShardCR : public RGWCoroutine {
   set<string>::iterator modified_iter;
 
   uint64_t total_entries = 0;
-  static constexpr int spawn_window = BUCKET_SHARD_SYNC_SPAWN_WINDOW;
+  const int spawn_window;
   bool *reset_backoff = nullptr;
 
   boost::intrusive_ptr<RGWContinuousLeaseCR> lease_cr;
@@ -1455,6 +1455,7 @@ public:
                      RGWSyncTraceNodeRef& _tn, bool *_reset_backoff)
     : RGWCoroutine(_sc->cct), sc(_sc), sync_env(_sc->env),
       pool(_pool), shard_id(_shard_id), sync_marker(_marker),
+      spawn_window(_sc->cct->_conf.get_val<int64_t>("rgw_data_sync_spawn_window")),
       status_oid(RGWDataSyncStatusManager::shard_obj_name(sc->source_zone, shard_id)),
       error_repo(pool, status_oid + ".retry"), tn(_tn),
       bucket_shard_cache(rgw::bucket_sync::Cache::create(target_cache_size))
@@ -3651,7 +3652,6 @@ done:
   }
 };
 
-#define BUCKET_SYNC_SPAWN_WINDOW 20
 
 class RGWBucketShardFullSyncCR : public RGWCoroutine {
   RGWDataSyncCtx *sc;
@@ -3666,6 +3666,7 @@ class RGWBucketShardFullSyncCR : public RGWCoroutine {
   bucket_list_entry *entry{nullptr};
 
   int total_entries{0};
+  const int spawn_window;
 
   int sync_status{0};
 
@@ -3731,6 +3732,7 @@ public:
     : RGWCoroutine(_sc->cct), sc(_sc), sync_env(_sc->env),
       sync_pipe(_sync_pipe), bs(_sync_pipe.info.source_bs),
       lease_cr(std::move(lease_cr)), sync_info(sync_info),
+      spawn_window(_sc->cct->_conf.get_val<int64_t>("rgw_bucket_sync_spawn_window")),
       status_oid(status_oid),
       tn(sync_env->sync_tracer->add_node(tn_parent, "full_sync",
                                          SSTR(bucket_shard_str{bs}))),
@@ -3801,7 +3803,7 @@ int RGWBucketShardFullSyncCR::operate()
                                  entry->key, &marker_tracker, zones_trace, tn),
                       false);
         }
-        while (num_spawned() > BUCKET_SYNC_SPAWN_WINDOW) {
+        while ((int)num_spawned() > spawn_window) {
           yield wait_for_child();
           bool again = true;
           while (again) {
@@ -3884,6 +3886,7 @@ class RGWBucketShardIncrementalSyncCR : public RGWCoroutine {
 
   int sync_status{0};
   bool syncstopped{false};
+  const int spawn_window;
 
   RGWSyncTraceNodeRef tn;
   RGWBucketIncSyncShardMarkerTrack marker_tracker;
@@ -3901,6 +3904,7 @@ public:
       sync_pipe(_sync_pipe), bs(_sync_pipe.info.source_bs),
       lease_cr(std::move(lease_cr)), sync_info(sync_info),
       zone_id(sync_env->svc->zone->get_zone().id),
+      spawn_window(_sc->cct->_conf.get_val<int64_t>("rgw_bucket_sync_spawn_window")),
       tn(sync_env->sync_tracer->add_node(_tn_parent, "inc_sync",
                                          SSTR(bucket_shard_str{bs}))),
       marker_tracker(sc, status_oid, sync_info.inc_marker, tn,
@@ -4106,7 +4110,7 @@ int RGWBucketShardIncrementalSyncCR::operate()
                   false);
           }
         // }
-        while (num_spawned() > BUCKET_SYNC_SPAWN_WINDOW) {
+        while ((int)num_spawned() > spawn_window) {
           set_status() << "num_spawned() > spawn_window";
           yield wait_for_child();
           bool again = true;
@@ -4310,7 +4314,8 @@ RGWRunBucketSourcesSyncCR::RGWRunBucketSourcesSyncCR(RGWDataSyncCtx *_sc,
     lease_cr(std::move(lease_cr)), target_bs(_target_bs), source_bs(_source_bs),
     tn(sync_env->sync_tracer->add_node(_tn_parent, "bucket_sync_sources",
                                        SSTR( "target=" << target_bucket.value_or(rgw_bucket()) << ":source_bucket=" << source_bucket.value_or(rgw_bucket()) << ":source_zone=" << sc->source_zone))),
-    progress(progress)
+    progress(progress),
+    spawn_window(_sc->cct->_conf.get_val<int64_t>("rgw_bucket_sync_spawn_window"))
 {
   if (target_bs) {
     target_bucket = target_bs->bucket;
@@ -4380,7 +4385,7 @@ int RGWRunBucketSourcesSyncCR::operate()
 
         yield spawn(new RGWRunBucketSyncCoroutine(sc, lease_cr, sync_pair, tn,
                                                   &*cur_shard_progress), false);
-        while (num_spawned() > BUCKET_SYNC_SPAWN_WINDOW) {
+        while ((int)num_spawned() > spawn_window) {
           set_status() << "num_spawned() > spawn_window";
           yield wait_for_child();
           again = true;
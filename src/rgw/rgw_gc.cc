@@ -327,7 +327,7 @@ public:
       if (gc->going_down()) {
         return 0;
       }
-      auto ret = handle_next_completion();
+      auto ret = handle_completions();
       //Return error if we are using queue, else ignore it
       if (gc->transitioned_objects_cache[index] && ret < 0) {
         return ret;
@@ -348,6 +348,39 @@ public:
     ceph_assert(!ios.empty());
     IO& io = ios.front();
     io.c->wait_for_complete();
+    int ret = handle_completion(io);
+    ios.pop_front();
+    return ret;
+  }
+
+  /* handle every io that has already completed, in whatever order they
+   * finished, so that one slow removal at the front does not hold back
+   * the whole window; only block if none has completed yet */
+  int handle_completions() {
+    std::vector<IO> completed;
+    for (auto it = ios.begin(); it != ios.end(); ) {
+      if (it->c->is_complete()) {
+        completed.push_back(std::move(*it));
+        it = ios.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    if (completed.empty()) {
+      return handle_next_completion();
+    }
+
+    int ret_val = 0;
+    for (auto& io : completed) {
+      auto ret = handle_completion(io);
+      if (ret < 0) {
+        ret_val = ret;
+      }
+    }
+    return ret_val;
+  }
+
+  int handle_completion(IO& io) {
     int ret = io.c->get_return_value();
     io.c->release();
 
@@ -374,7 +407,6 @@ public:
     }
 
   done:
-    ios.pop_front();
     return ret;
   }
 
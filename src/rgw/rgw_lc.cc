@@ -712,6 +712,10 @@ public:
 
   void drain() {
     unique_lock uniq(mtx);
+    if (items.empty() && (flags & FLAG_DWAIT_SYNC)) {
+      /* the worker is already idle waiting for work */
+      return;
+    }
     flags |= FLAG_EDRAIN_SYNC;
     while (flags & FLAG_EDRAIN_SYNC) {
       cv.wait_for(uniq, 200ms);
@@ -726,6 +730,7 @@ private:
       /* clear drain state, as we are NOT doing work and qlen==0 */
       if (flags & FLAG_EDRAIN_SYNC) {
 	flags &= ~FLAG_EDRAIN_SYNC;
+	cv.notify_one();
       }
       flags |= FLAG_DWAIT_SYNC;
       cv.wait_for(uniq, 200ms);
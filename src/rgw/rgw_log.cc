@@ -96,6 +96,9 @@ class UsageLogger {
   ceph::mutex timer_lock = ceph::make_mutex("UsageLogger::timer_lock");
   SafeTimer timer;
   utime_t round_timestamp;
+  // set while a threshold flush is queued or running; checked without
+  // timer_lock, which the SafeTimer holds for as long as a flush runs
+  std::atomic<bool> flush_pending = false;
 
   class C_UsageLogTimeout : public Context {
     UsageLogger *logger;
@@ -107,6 +110,18 @@ class UsageLogger {
     }
   };
 
+  // a flush requested by insert_user() once the threshold is crossed, so
+  // the request thread that crossed it does not wait on the rados writes
+  class C_UsageLogFlush : public Context {
+    UsageLogger *logger;
+  public:
+    explicit C_UsageLogFlush(UsageLogger *_l) : logger(_l) {}
+    void finish(int r) override {
+      logger->flush();
+      logger->flush_pending = false;
+    }
+  };
+
   void set_timer() {
     timer.add_event_after(cct->_conf->rgw_usage_log_tick_interval, new C_UsageLogTimeout(this));
   }
@@ -145,9 +160,9 @@ public:
       num_entries++;
     bool need_flush = (num_entries > cct->_conf->rgw_usage_log_flush_threshold);
     lock.unlock();
-    if (need_flush) {
+    if (need_flush && !flush_pending.exchange(true)) {
       std::lock_guard l{timer_lock};
-      flush();
+      timer.add_event_after(0, new C_UsageLogFlush(this));
     }
   }
 
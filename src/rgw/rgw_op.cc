@@ -2092,10 +2092,18 @@ bool RGWGetObj::prefetch_data()
   }
 
   range_str = s->info.env->get("HTTP_RANGE");
-  // TODO: add range prefetch
   if (range_str) {
     parse_range();
-    return false;
+    /* the prefetch reads the first rgw_max_chunk_size bytes of the head
+     * along with its attrs, so only use it for ranges that need all of
+     * them anyway, like the first part of a parallel download */
+    if (!range_parsed || ofs != 0) {
+      return false;
+    }
+    if (end >= 0 && static_cast<uint64_t>(end) + 1 <
+        s->cct->_conf->rgw_max_chunk_size) {
+      return false;
+    }
   }
 
   return get_data;
@@ -1781,6 +1781,9 @@ int RGWRados::Bucket::List::list_objects_ordered(
   }
 
   rgw_obj_index_key prev_marker;
+  // shards with nothing left past cur_marker; the marker only moves
+  // forward across attempts, so they can be skipped from then on
+  std::set<int> exhausted_shards;
   for (uint16_t attempt = 1; /* empty */; ++attempt) {
     ldout(cct, 20) << "RGWRados::Bucket::List::" << __func__ <<
       " starting attempt " << attempt << dendl;
@@ -1809,7 +1812,9 @@ int RGWRados::Bucket::List::list_objects_ordered(
 					   &truncated,
 					   &cls_filtered,
 					   &cur_marker,
-                                           y);
+                                           y,
+					   nullptr,
+					   &exhausted_shards);
     if (r < 0) {
       return r;
     }
@@ -6279,6 +6284,10 @@ struct get_obj_data {
   uint64_t offset; // next offset to write to client
   rgw::AioResultList completed; // completed read results, sorted by offset
   optional_yield yield;
+  // pool opened for the previous read; the stripes of an object normally
+  // share it, so reuse its IoCtx rather than creating one per read
+  RGWSI_RADOS::Pool pool;
+  bool pool_open = false;
 
   get_obj_data(RGWRados* store, RGWGetDataCB* cb, rgw::Aio* aio,
                uint64_t offset, optional_yield yield)
@@ -6367,12 +6376,23 @@ int RGWRados::get_obj_iterate_cb(const rgw_raw_obj& read_obj, off_t obj_ofs,
     }
   }
 
-  auto obj = d->store->svc.rados->obj(read_obj);
-  int r = obj.open();
-  if (r < 0) {
-    ldout(cct, 4) << "failed to open rados context for " << read_obj << dendl;
-    return r;
+  if (!d->pool_open || d->pool.get_pool() != read_obj.pool) {
+    d->pool = d->store->svc.rados->pool(read_obj.pool);
+    d->pool_open = false;
+    int r = d->pool.open();
+    if (r < 0) {
+      ldout(cct, 4) << "failed to open rados context for " << read_obj << dendl;
+      return r;
+    }
+    d->pool_open = true;
   }
+  auto obj = d->store->svc.rados->obj(d->pool, read_obj.oid);
+  // copying the Pool shares its IoCtxImpl with the other reads in flight;
+  // give this read a private one so setting the locator cannot reach them.
+  // dup() only copies the already resolved pool state.
+  librados::IoCtx& ioctx = obj.get_ref().pool.ioctx();
+  ioctx.dup(d->pool.ioctx());
+  ioctx.locator_set_key(read_obj.loc);
 
   ldout(cct, 20) << "rados->get_obj_iterate_cb oid=" << read_obj.oid << " obj-ofs=" << obj_ofs << " read_ofs=" << read_ofs << " len=" << len << dendl;
   op.read(read_ofs, len, nullptr, nullptr);
@@ -8279,13 +8299,18 @@ int RGWRados::cls_bucket_list_ordered(RGWBucketInfo& bucket_info,
 				      bool* cls_filtered,
 				      rgw_obj_index_key *last_entry,
                                       optional_yield y,
-				      check_filter_t force_check_filter)
+				      check_filter_t force_check_filter,
+				      std::set<int>* exhausted_shards)
 {
   /* expansion_factor allows the number of entries to read to grow
    * exponentially; this is used when earlier reads are producing too
    * few results, perhaps due to filtering or to a series of
    * namespaced entries */
 
+  /* exhausted_shards, if given, holds the shards an earlier call with a
+   * start_after no later than this one found to have nothing left; they
+   * are not queried and the shards this call exhausts are added to it */
+
   ldout(cct, 10) << "RGWRados::" << __func__ << ": " << bucket_info.bucket <<
     " start_after=\"" << start_after.name <<
     "[" << start_after.instance <<
@@ -8308,6 +8333,23 @@ int RGWRados::cls_bucket_list_ordered(RGWBucketInfo& bucket_info,
     return r;
   }
 
+  if (exhausted_shards) {
+    for (auto shard : *exhausted_shards) {
+      shard_oids.erase(shard);
+    }
+    if (shard_oids.empty()) {
+      ldout(cct, 10) << "RGWRados::" << __func__ <<
+	": all shards exhausted" << dendl;
+      // callers read these back as on any other successful return
+      *is_truncated = false;
+      *cls_filtered = false;
+      if (last_entry) {
+	*last_entry = start_after;
+      }
+      return 0;
+    }
+  }
+
   const uint32_t shard_count = shard_oids.size();
   uint32_t num_entries_per_shard;
   if (expansion_factor == 0) {
@@ -8506,7 +8548,10 @@ int RGWRados::cls_bucket_list_ordered(RGWBucketInfo& bucket_info,
   for (const auto& t : results_trackers) {
     if (!t.at_end() || t.is_truncated()) {
       *is_truncated = true;
-      break;
+    } else if (exhausted_shards) {
+      // every entry of this shard up to the end of its index has been
+      // consumed, so later pages cannot get anything from it
+      exhausted_shards->insert(t.shard_idx);
     }
   }
 
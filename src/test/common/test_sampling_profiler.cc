@@ -0,0 +1,82 @@
+// -*- mode:C++; tab-width:8; c-basic-offset:2; indent-tabs-mode:t -*-
+// vim: ts=8 sw=2 smarttab
+
+#include <chrono>
+#include <cstring>
+#include <signal.h>
+#include <sstream>
+#include <string>
+#include <gtest/gtest.h>
+
+#include "common/Formatter.h"
+#include "common/SamplingProfiler.h"
+
+namespace sp = ceph::sampling_profiler;
+
+// keep the spinning out of line, so it shows up in the folded stacks
+void sampling_profiler_spin(std::chrono::milliseconds d)
+{
+  volatile uint64_t x = 0;
+  auto until = std::chrono::steady_clock::now() + d;
+  while (std::chrono::steady_clock::now() < until) {
+    x = x + 1;
+  }
+}
+
+TEST(SamplingProfiler, BadRate) {
+  std::ostringstream ss;
+  ASSERT_EQ(-EINVAL, sp::start(0, ss));
+  ASSERT_EQ(-EINVAL, sp::start(sp::MAX_HZ + 1, ss));
+}
+
+TEST(SamplingProfiler, Folded) {
+  std::ostringstream ss;
+  ASSERT_EQ(0, sp::start(sp::MAX_HZ, ss));
+  sampling_profiler_spin(std::chrono::milliseconds(500));
+  ASSERT_EQ(0, sp::stop(ss));
+
+  std::ostringstream out;
+  sp::dump_folded(out);
+  std::string folded = out.str();
+  ASSERT_FALSE(folded.empty());
+  // every line ends with " <count>"
+  std::istringstream lines(folded);
+  std::string line;
+  while (std::getline(lines, line)) {
+    auto pos = line.rfind(' ');
+    ASSERT_NE(std::string::npos, pos);
+    ASSERT_GT(std::stoul(line.substr(pos + 1)), 0u);
+  }
+  ASSERT_NE(std::string::npos, folded.find("sampling_profiler_spin"));
+
+  sp::reset();
+  std::ostringstream empty;
+  sp::dump_folded(empty);
+  ASSERT_TRUE(empty.str().empty());
+}
+
+static void other_sigprof_handler(int)
+{
+}
+
+TEST(SamplingProfiler, SigprofInUse) {
+  struct sigaction sa, old;
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = other_sigprof_handler;
+  sigemptyset(&sa.sa_mask);
+  ASSERT_EQ(0, ::sigaction(SIGPROF, &sa, &old));
+  std::ostringstream ss;
+  ASSERT_EQ(-EBUSY, sp::start(sp::MAX_HZ, ss));
+  // the other handler is left in place
+  struct sigaction cur;
+  ASSERT_EQ(0, ::sigaction(SIGPROF, nullptr, &cur));
+  ASSERT_EQ(other_sigprof_handler, cur.sa_handler);
+
+  ASSERT_EQ(0, ::sigaction(SIGPROF, &old, nullptr));
+  ASSERT_EQ(0, sp::start(sp::MAX_HZ, ss));
+  ASSERT_EQ(0, sp::stop(ss));
+  // and SIGPROF is free again once we are done with it
+  ASSERT_EQ(0, ::sigaction(SIGPROF, nullptr, &cur));
+  ASSERT_EQ(SIG_IGN, cur.sa_handler);
+  sp::reset();
+}
@@ -0,0 +1,199 @@
+// -*- mode:C++; tab-width:8; c-basic-offset:2; indent-tabs-mode:t -*-
+// vim: ts=8 sw=2 smarttab
+
+#include "test/crimson/gtest_seastar.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "crimson/common/log.h"
+#include "crimson/os/seastore/segment_manager/block.h"
+
+using namespace crimson;
+using namespace crimson::os;
+using namespace crimson::os::seastore;
+using namespace crimson::os::seastore::segment_manager::block;
+
+namespace {
+  [[maybe_unused]] seastar::logger& logger() {
+    return crimson::get_logger(ceph_subsys_test);
+  }
+}
+
+/// turn an errorated future into 0 or the negated error code
+template <typename Fut>
+static int errno_of(Fut &&fut) {
+  return std::forward<Fut>(fut).safe_then(
+    [](auto&&...) { return 0; },
+    crimson::ct_error::all_same_way([](const std::error_code &e) {
+      return -e.value();
+    })).unsafe_get0();
+}
+
+struct block_segment_manager_test_t : seastar_test_suite_t {
+  static constexpr size_t DEVICE_SIZE = 8 << 20;
+  static constexpr size_t SEGMENT_SIZE = 1 << 20;
+
+  const std::string path =
+    "test_block_segment_manager." + std::to_string(getpid());
+  std::unique_ptr<BlockSegmentManager> segment_manager;
+
+  seastar::future<> set_up_fut() final {
+    int fd = ::open(path.c_str(), O_CREAT|O_TRUNC|O_RDWR, 0644);
+    ceph_assert(fd >= 0);
+    ceph_assert(::ftruncate(fd, DEVICE_SIZE) == 0);
+    ::close(fd);
+    return BlockSegmentManager::mkfs(path, SEGMENT_SIZE
+    ).safe_then([this] {
+      return mount();
+    }).handle_error(
+      crimson::ct_error::all_same_way([] {
+	ASSERT_FALSE("Unable to mkfs");
+      }));
+  }
+
+  seastar::future<> tear_down_fut() final {
+    return segment_manager->close(
+    ).handle_error(
+      crimson::ct_error::all_same_way([] {
+	ASSERT_FALSE("Unable to close");
+      })
+    ).finally([this] {
+      ::unlink(path.c_str());
+    });
+  }
+
+  SegmentManager::init_ertr::future<> mount() {
+    segment_manager = std::make_unique<BlockSegmentManager>(path);
+    return segment_manager->init();
+  }
+
+  /// close the device and open it again, as after a restart
+  void remount() {
+    segment_manager->close().unsafe_get0();
+    mount().unsafe_get0();
+  }
+
+  bufferlist make_data(size_t len, char c) {
+    bufferlist bl;
+    bl.append(buffer::ptr(buffer::create(len, c)));
+    return bl;
+  }
+
+  void check_read(paddr_t addr, const bufferlist &expected) {
+    auto bp = segment_manager->read(addr, expected.length()).unsafe_get0();
+    bufferlist bl;
+    bl.push_back(bp);
+    ASSERT_TRUE(bl.contents_equal(expected));
+  }
+};
+
+TEST_F(block_segment_manager_test_t, geometry)
+{
+  run_async([this] {
+    auto block_size = segment_manager->get_block_size();
+    EXPECT_GE(block_size, 4096);
+    EXPECT_EQ(SEGMENT_SIZE, (size_t)segment_manager->get_segment_size());
+    // the superblock and the state tracker take the head of the device
+    EXPECT_GT(segment_manager->get_num_segments(), 0u);
+    EXPECT_LT(segment_manager->get_size(), DEVICE_SIZE);
+  });
+}
+
+TEST_F(block_segment_manager_test_t, write_read)
+{
+  run_async([this] {
+    auto block_size = segment_manager->get_block_size();
+    auto segment = segment_manager->open(0).unsafe_get0();
+    EXPECT_EQ(0u, segment->get_segment_id());
+    EXPECT_EQ(0, segment->get_write_ptr());
+
+    auto first = make_data(block_size, 'a');
+    auto second = make_data(3 * block_size, 'b');
+    segment->write(0, first).unsafe_get0();
+    segment->write(block_size, second).unsafe_get0();
+    EXPECT_EQ(4 * block_size, segment->get_write_ptr());
+
+    check_read({0, 0}, first);
+    check_read({0, block_size}, second);
+
+    // a short write is padded out to the block size
+    auto tail = make_data(100, 'c');
+    segment->write(4 * block_size, tail).unsafe_get0();
+    EXPECT_EQ(5 * block_size, segment->get_write_ptr());
+    auto bp = segment_manager->read({0, 4 * block_size}, block_size).unsafe_get0();
+    bufferlist bl;
+    bl.push_back(bp);
+    bufferlist head;
+    head.substr_of(bl, 0, tail.length());
+    EXPECT_TRUE(head.contents_equal(tail));
+
+    segment->close().unsafe_get0();
+  });
+}
+
+TEST_F(block_segment_manager_test_t, write_errors)
+{
+  run_async([this] {
+    auto block_size = segment_manager->get_block_size();
+    auto segment = segment_manager->open(1).unsafe_get0();
+    auto data = make_data(block_size, 'd');
+
+    // misaligned, behind the write pointer, and past the segment end
+    EXPECT_EQ(-EINVAL, errno_of(segment->write(1, data)));
+    segment->write(block_size, data).unsafe_get0();
+    EXPECT_EQ(-EINVAL, errno_of(segment->write(0, data)));
+    EXPECT_EQ(-ENOSPC, errno_of(segment->write(SEGMENT_SIZE, data)));
+
+    // an open segment can not be opened again or released
+    EXPECT_EQ(-EINVAL, errno_of(segment_manager->open(1)));
+    EXPECT_EQ(-EINVAL, errno_of(segment_manager->release(1)));
+
+    segment->close().unsafe_get0();
+    EXPECT_EQ(-EBADF, errno_of(segment->write(2 * block_size, data)));
+    EXPECT_EQ(-EINVAL, errno_of(segment->close()));
+
+    EXPECT_EQ(-EINVAL, errno_of(
+      segment_manager->open(segment_manager->get_num_segments())));
+  });
+}
+
+TEST_F(block_segment_manager_test_t, state_survives_restart)
+{
+  run_async([this] {
+    auto block_size = segment_manager->get_block_size();
+    auto closed = make_data(2 * block_size, 'e');
+    auto open = make_data(block_size, 'f');
+    {
+      auto segment = segment_manager->open(0).unsafe_get0();
+      segment->write(0, closed).unsafe_get0();
+      segment->close().unsafe_get0();
+    }
+    {
+      // left open, as by a crash
+      auto segment = segment_manager->open(1).unsafe_get0();
+      segment->write(0, open).unsafe_get0();
+    }
+
+    remount();
+
+    // the data is still there, and both segments now count as closed
+    check_read({0, 0}, closed);
+    check_read({1, 0}, open);
+    EXPECT_EQ(-EINVAL, errno_of(segment_manager->open(0)));
+    EXPECT_EQ(-EINVAL, errno_of(segment_manager->open(1)));
+
+    // release clears the segment header and makes it reusable
+    segment_manager->release(0).unsafe_get0();
+    segment_manager->release(1).unsafe_get0();
+    EXPECT_EQ(-EINVAL, errno_of(segment_manager->release(0)));
+    check_read({0, 0}, make_data(block_size, 0));
+
+    remount();
+
+    auto segment = segment_manager->open(0).unsafe_get0();
+    segment->write(0, open).unsafe_get0();
+    check_read({0, 0}, open);
+    segment->close().unsafe_get0();
+  });
+}
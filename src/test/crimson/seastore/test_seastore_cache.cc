@@ -6,6 +6,7 @@
 #include "crimson/common/log.h"
 #include "crimson/os/seastore/cache.h"
 #include "crimson/os/seastore/segment_manager/ephemeral.h"
+#include "crimson/os/seastore/lba_manager/btree/lba_btree_node_impl.h"
 
 #include "test/crimson/seastore/test_block.h"
 
@@ -24,9 +25,9 @@ struct cache_test_t : public seastar_test_suite_t {
   Cache cache;
   paddr_t current{0, 0};
 
-  cache_test_t()
+  cache_test_t(size_t pinned_capacity = Cache::DEFAULT_PINNED_CAPACITY)
     : segment_manager(segment_manager::DEFAULT_TEST_EPHEMERAL),
-      cache(segment_manager) {}
+      cache(segment_manager, pinned_capacity) {}
 
   seastar::future<std::optional<paddr_t>> submit_transaction(
     TransactionRef t) {
@@ -231,3 +232,78 @@ TEST_F(cache_test_t, test_dirty_extent)
     }
   });
 }
+
+struct cache_pin_test_t : public cache_test_t {
+  // room for two LBA nodes, so that pinning a third one evicts
+  cache_pin_test_t()
+    : cache_test_t(2 * lba_manager::btree::LBA_BLOCK_SIZE) {}
+};
+
+TEST_F(cache_pin_test_t, test_lba_internal_nodes_pinned)
+{
+  run_async([this] {
+    using lba_manager::btree::LBAInternalNode;
+    using lba_manager::btree::LBALeafNode;
+    using lba_manager::btree::LBA_BLOCK_SIZE;
+
+    auto alloc_internal = [this](auto &t) {
+      auto node = cache.alloc_new_extent<LBAInternalNode>(t, LBA_BLOCK_SIZE);
+      node->set_size(0);
+      return node;
+    };
+
+    std::vector<paddr_t> internal;
+    paddr_t leaf_addr;
+    paddr_t block_addr;
+    {
+      auto t = get_transaction();
+      std::vector<CachedExtentRef> nodes;
+      for (int i = 0; i < 3; ++i) {
+	nodes.push_back(alloc_internal(*t));
+      }
+      auto leaf = cache.alloc_new_extent<LBALeafNode>(*t, LBA_BLOCK_SIZE);
+      leaf->set_size(0);
+      auto block = cache.alloc_new_extent<TestBlock>(*t, TestBlock::SIZE);
+      block->set_contents('p');
+      auto ret = submit_transaction(std::move(t)).get0();
+      ASSERT_TRUE(ret);
+      for (auto &i : nodes) {
+	internal.push_back(i->get_paddr());
+      }
+      leaf_addr = leaf->get_paddr();
+      block_addr = block->get_paddr();
+    }
+
+    // with the transaction refs gone, only the two most recently pinned
+    // internal nodes are still cached; leaves and data are not held
+    EXPECT_FALSE(cache.test_query_cache(internal[0]));
+    EXPECT_TRUE(cache.test_query_cache(internal[1]));
+    EXPECT_TRUE(cache.test_query_cache(internal[2]));
+    EXPECT_FALSE(cache.test_query_cache(leaf_addr));
+    EXPECT_FALSE(cache.test_query_cache(block_addr));
+
+    {
+      // a hit makes internal[1] the most recently used
+      auto t = get_transaction();
+      auto node = cache.get_extent<LBAInternalNode>(
+	*t,
+	internal[1],
+	LBA_BLOCK_SIZE).unsafe_get0();
+      ASSERT_EQ(internal[1], node->get_paddr());
+    }
+
+    paddr_t newest;
+    {
+      auto t = get_transaction();
+      auto node = alloc_internal(*t);
+      auto ret = submit_transaction(std::move(t)).get0();
+      ASSERT_TRUE(ret);
+      newest = node->get_paddr();
+    }
+
+    // so pinning another node evicts internal[2] instead
+    EXPECT_TRUE(cache.test_query_cache(internal[1]));
+    EXPECT_FALSE(cache.test_query_cache(internal[2]));
+    EXPECT_TRUE(cache.test_query_cache(newest));
+  });
+}
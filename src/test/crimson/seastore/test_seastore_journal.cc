@@ -156,6 +156,20 @@ struct journal_test_t : seastar_test_suite_t, JournalSegmentProvider {
     return addr;
   }
 
+  /// submit all of to_submit before waiting on any, so they share a batch
+  void submit_records_together(std::vector<record_t> &&to_submit) {
+    std::vector<Journal::submit_record_ret> futures;
+    auto first = records.size();
+    for (auto &&record : to_submit) {
+      records.push_back(record);
+      futures.push_back(journal->submit_record(std::move(record)));
+    }
+    for (size_t i = 0; i < futures.size(); ++i) {
+      records[first + i].record_final_offset =
+	std::move(futures[i]).unsafe_get0();
+    }
+  }
+
   seastar::future<> tear_down_fut() final {
     return seastar::now();
   }
@@ -257,3 +271,35 @@ TEST_F(journal_test_t, roll_journal_and_replay)
    replay_and_check();
  });
 }
+
+TEST_F(journal_test_t, replay_batched_records)
+{
+ run_async([this] {
+   auto make_batch = [this](int n) {
+     std::vector<record_t> batch;
+     for (int i = 0; i < n; ++i) {
+       batch.push_back(record_t{
+	 { generate_extent(1 + i % 3) },
+	 { generate_delta(23 + i), generate_delta(30) }
+	 });
+     }
+     return batch;
+   };
+   submit_records_together(make_batch(5));
+   // records in one batch are laid out back to back in submit order
+   for (size_t i = 1; i < records.size(); ++i) {
+     auto prev = records[i - 1].record_final_offset;
+     auto cur = records[i].record_final_offset;
+     ASSERT_EQ(prev.segment, cur.segment);
+     ASSERT_LT(prev.offset, cur.offset);
+   }
+   // replay reopens the journal as after a restart
+   replay_and_check();
+   submit_record(record_t{
+     { generate_extent(2) },
+     { generate_delta(40) }
+     });
+   submit_records_together(make_batch(3));
+   replay_and_check();
+ });
+}
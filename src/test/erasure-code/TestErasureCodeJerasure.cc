@@ -129,6 +129,53 @@ TYPED_TEST(ErasureCodeTest, encode_decode)
   }
 }
 
+TYPED_TEST(ErasureCodeTest, encode_chunks_in_place)
+{
+  TypeParam jerasure;
+  ErasureCodeProfile profile;
+  profile["k"] = "2";
+  profile["m"] = "2";
+  profile["packetsize"] = "8";
+  jerasure.init(profile, &cerr);
+  ASSERT_TRUE(jerasure.can_encode_chunks_in_place());
+
+  const unsigned stripe_width = jerasure.get_chunk_size(1) * 2;
+  const unsigned chunk_size = stripe_width / 2;
+  const unsigned stripes = 3;
+  bufferptr in_ptr(buffer::create_page_aligned(stripe_width * stripes));
+  for (unsigned i = 0; i < in_ptr.length(); i++)
+    in_ptr[i] = i * 7;
+  bufferlist in;
+  in.push_back(in_ptr);
+  set<int> want = { 0, 1, 2, 3 };
+
+  // coding chunks for all stripes share one buffer per chunk index
+  bufferptr coding[2] = {
+    buffer::create_page_aligned(chunk_size * stripes),
+    buffer::create_page_aligned(chunk_size * stripes)
+  };
+  for (unsigned s = 0; s < stripes; s++) {
+    map<int, bufferlist> chunks;
+    for (int i = 0; i < 2; i++) {
+      chunks[i].substr_of(in, s * stripe_width + i * chunk_size, chunk_size);
+      chunks[i + 2].append(coding[i], s * chunk_size, chunk_size);
+    }
+    EXPECT_EQ(0, jerasure.encode_chunks(want, &chunks));
+  }
+
+  for (unsigned s = 0; s < stripes; s++) {
+    bufferlist stripe;
+    stripe.substr_of(in, s * stripe_width, stripe_width);
+    map<int, bufferlist> encoded;
+    EXPECT_EQ(0, jerasure.encode(want, stripe, &encoded));
+    for (int i = 0; i < 2; i++) {
+      EXPECT_EQ(0, memcmp(encoded[i + 2].c_str(),
+			  coding[i].c_str() + s * chunk_size,
+			  chunk_size));
+    }
+  }
+}
+
 TYPED_TEST(ErasureCodeTest, minimum_to_decode)
 {
   TypeParam jerasure;
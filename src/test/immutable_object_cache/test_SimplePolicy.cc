@@ -233,3 +233,24 @@ TEST_F(TestSimplePolicy, test_evict_list_10) {
     m_promoted_lru.erase(m_promoted_lru.begin());
   }
 }
+
+TEST(SimplePolicyThreshold, promote_after_threshold_misses) {
+  SimplePolicy policy(g_ceph_context, 100, 128, 0.1, 3);
+  std::string name("promote_threshold_file");
+
+  ASSERT_EQ(OBJ_CACHE_SKIP, policy.lookup_object(name));
+  ASSERT_EQ(OBJ_CACHE_NONE, policy.get_status(name));
+  ASSERT_EQ(OBJ_CACHE_SKIP, policy.lookup_object(name));
+  ASSERT_EQ(OBJ_CACHE_NONE, policy.get_status(name));
+  ASSERT_EQ(0U, policy.get_promoting_entry_num());
+
+  // third miss starts the promotion
+  ASSERT_EQ(OBJ_CACHE_NONE, policy.lookup_object(name));
+  ASSERT_EQ(OBJ_CACHE_SKIP, policy.get_status(name));
+  ASSERT_EQ(1U, policy.get_promoting_entry_num());
+
+  policy.update_status(name, OBJ_CACHE_PROMOTED, 1);
+  ASSERT_EQ(OBJ_CACHE_PROMOTED, policy.lookup_object(name));
+  policy.evict_entry(name);
+  ASSERT_EQ(OBJ_CACHE_NONE, policy.get_status(name));
+}
@@ -25,12 +25,17 @@ using namespace std;
 #include "common/ceph_argparse.h"
 #include "common/debug.h"
 #include "common/Cycles.h"
+#include "common/Formatter.h"
 #include "global/global_init.h"
 #include "msg/Messenger.h"
 #include "messages/MOSDOp.h"
+#include "messages/MOSDOpReply.h"
 #include "auth/DummyAuth.h"
 
+#include <algorithm>
 #include <atomic>
+#include <map>
+#include <memory>
 
 class MessengerClient {
   class ClientThread;
@@ -79,6 +84,9 @@ class MessengerClient {
     ceph::mutex lock = ceph::make_mutex("MessengerBenchmark::ClientThread::lock");
     ceph::condition_variable cond;
     uint64_t inflight;
+    // send time of each in-flight op, and round trip latency of completed ones
+    std::map<ceph_tid_t, ceph::mono_time> sent;
+    vector<uint64_t> lat_ns;
 
     ClientThread(Messenger *m, int c, ConnectionRef con, int len, int ops, int think_time_us):
         msgr(m), concurrent(c), conn(con), oid("object-name"), oloc(1, 1), msg_len(len), ops(ops),
@@ -97,13 +105,15 @@ class MessengerClient {
 	hobject_t hobj(oid, oloc.key, CEPH_NOSNAP, pgid.ps(), pgid.pool(),
 		       oloc.nspace);
 	spg_t spgid(pgid);
-        MOSDOp *m = new MOSDOp(client_inc, 0, hobj, spgid, 0, 0, 0);
+        MOSDOp *m = new MOSDOp(client_inc, i + 1, hobj, spgid, 0, 0, 0);
         bufferlist msg_data(data);
         m->write(0, msg_len, msg_data);
         inflight++;
+        sent[i + 1] = ceph::mono_clock::now();
         conn->send_message(m);
         //cerr << __func__ << " send m=" << m << std::endl;
       }
+      cond.wait(locker, [this] { return inflight == 0; });
       locker.unlock();
       msgr->shutdown();
       return 0;
@@ -154,19 +164,45 @@ class MessengerClient {
     for (uint64_t i = 0; i < msgrs.size(); ++i)
       msgrs[i]->wait();
   }
+  vector<uint64_t> get_latencies() {
+    vector<uint64_t> lat;
+    for (auto c : clients) {
+      std::lock_guard l{c->lock};
+      lat.insert(lat.end(), c->lat_ns.begin(), c->lat_ns.end());
+    }
+    std::sort(lat.begin(), lat.end());
+    return lat;
+  }
 };
 
 void MessengerClient::ClientDispatcher::ms_fast_dispatch(Message *m) {
+  auto now = ceph::mono_clock::now();
+  ceph_tid_t tid = static_cast<MOSDOpReply*>(m)->get_tid();
   usleep(think_time);
   m->put();
   std::lock_guard l{thread->lock};
+  auto p = thread->sent.find(tid);
+  if (p != thread->sent.end()) {
+    thread->lat_ns.push_back(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(now - p->second).count());
+    thread->sent.erase(p);
+  }
   thread->inflight--;
   thread->cond.notify_all();
 }
 
+static uint64_t percentile(const vector<uint64_t> &sorted, double pct)
+{
+  if (sorted.empty())
+    return 0;
+  size_t i = std::min<size_t>(sorted.size() * pct / 100.0, sorted.size() - 1);
+  return sorted[i];
+}
+
 
 void usage(const string &name) {
-  cout << "Usage: " << name << " [server ip:port] [numjobs] [concurrency] [ios] [thinktime us] [msg length]" << std::endl;
+  cout << "Usage: " << name << " [--format json|json-pretty|xml] [server ip:port] [numjobs] [concurrency] [ios] [thinktime us] [msg length]" << std::endl;
+  cout << "       [--format]: also dump throughput and latency percentiles with this formatter" << std::endl;
   cout << "       [server ip:port]: connect to the ip:port pair" << std::endl;
   cout << "       [numjobs]: how much client threads spawned and do benchmark" << std::endl;
   cout << "       [concurrency]: the max inflight messages(like iodepth in fio)" << std::endl;
@@ -186,6 +222,16 @@ int main(int argc, char **argv)
   common_init_finish(g_ceph_context);
   g_ceph_context->_conf.apply_changes(nullptr);
 
+  std::string format;
+  for (auto i = args.begin(); i != args.end();) {
+    std::string val;
+    if (ceph_argparse_witharg(args, i, &val, "--format", (char*)NULL)) {
+      format = val;
+    } else {
+      ++i;
+    }
+  }
+
   if (args.size() < 6) {
     usage(argv[0]);
     return 1;
@@ -214,7 +260,38 @@ int main(int argc, char **argv)
   uint64_t start = Cycles::rdtsc();
   client.start();
   uint64_t stop = Cycles::rdtsc();
-  cout << " Total op " << (ios * numjobs) << " run time " << Cycles::to_microseconds(stop - start) << "us." << std::endl;
+  uint64_t run_us = Cycles::to_microseconds(stop - start);
+  cout << " Total op " << (ios * numjobs) << " run time " << run_us << "us." << std::endl;
+
+  auto lat = client.get_latencies();
+  cout << " latency(us) p50 " << percentile(lat, 50) / 1000
+       << " p90 " << percentile(lat, 90) / 1000
+       << " p99 " << percentile(lat, 99) / 1000
+       << " p99.9 " << percentile(lat, 99.9) / 1000
+       << " max " << (lat.empty() ? 0 : lat.back() / 1000) << std::endl;
+
+  if (!format.empty()) {
+    std::unique_ptr<Formatter> f(Formatter::create(format, "json-pretty", "json-pretty"));
+    f->open_object_section("perf_msgr_client");
+    f->dump_string("ms_type", public_msgr_type);
+    f->dump_int("numjobs", numjobs);
+    f->dump_int("concurrency", concurrent);
+    f->dump_int("ios", ios);
+    f->dump_int("msg_len", len);
+    f->dump_unsigned("run_time_us", run_us);
+    f->dump_float("ops_per_sec", run_us ? (double)ios * numjobs * 1000000 / run_us : 0);
+    f->dump_float("bytes_per_sec", run_us ? (double)ios * numjobs * len * 1000000 / run_us : 0);
+    f->open_object_section("latency_ns");
+    f->dump_unsigned("p50", percentile(lat, 50));
+    f->dump_unsigned("p90", percentile(lat, 90));
+    f->dump_unsigned("p99", percentile(lat, 99));
+    f->dump_unsigned("p999", percentile(lat, 99.9));
+    f->dump_unsigned("max", lat.empty() ? 0 : lat.back());
+    f->close_section();
+    f->close_section();
+    f->flush(cout);
+    cout << std::endl;
+  }
 
   return 0;
 }
@@ -34,6 +34,55 @@ TEST_F(TestNeoRADOS, MakeWithLibRADOS) {
     boost::system::system_error);
 }
 
+TEST_F(TestNeoRADOS, BatchReadResultPerOp) {
+  librados::Rados paleo_rados;
+  auto pool_name = get_temp_pool_name();
+  ASSERT_EQ("", create_one_pool_pp(pool_name, paleo_rados));
+
+  {
+    auto rados = RADOS::make_with_librados(paleo_rados);
+    IOContext ioc(paleo_rados.pool_lookup(pool_name.c_str()));
+
+    for (auto [name, data] : {std::pair{"obj-a", "aaaa"},
+			      std::pair{"obj-b", "bbbbbbbb"}}) {
+      WriteOp op;
+      bufferlist bl;
+      bl.append(data);
+      op.write_full(std::move(bl));
+      rados.execute(name, ioc, std::move(op), ceph::async::use_blocked);
+    }
+
+    // a missing object in the middle fails only its own read
+    bufferlist a, b, missing;
+    std::vector<RADOS::BatchRead> reads(3);
+    reads[0].obj = "obj-a";
+    reads[0].op.read(0, 0, &a);
+    reads[1].obj = "obj-missing";
+    reads[1].op.read(0, 0, &missing);
+    reads[2].obj = "obj-b";
+    reads[2].op.read(0, 0, &b);
+
+    boost::system::error_code ec;
+    auto ecs = rados.execute(ioc, std::move(reads),
+			     ceph::async::use_blocked[ec]);
+    EXPECT_EQ(ENOENT, ec.value());
+    ASSERT_EQ(3u, ecs.size());
+    EXPECT_FALSE(ecs[0]);
+    EXPECT_EQ(ENOENT, ecs[1].value());
+    EXPECT_FALSE(ecs[2]);
+    EXPECT_EQ("aaaa", a.to_str());
+    EXPECT_EQ("bbbbbbbb", b.to_str());
+
+    // an empty batch completes at once, without errors
+    ecs = rados.execute(ioc, std::vector<RADOS::BatchRead>{},
+			ceph::async::use_blocked[ec]);
+    EXPECT_FALSE(ec);
+    EXPECT_TRUE(ecs.empty());
+  }
+
+  ASSERT_EQ(0, destroy_one_pool_pp(pool_name, paleo_rados));
+}
+
 } // namespace neorados
 
 int main(int argc, char **argv) {
@@ -16,6 +16,8 @@
 #include <stdio.h>
 #include <string.h>
 #include <iostream>
+#include <mutex>
+#include <thread>
 #include <time.h>
 #include <sys/mount.h>
 #include <boost/scoped_ptr.hpp>
@@ -4728,6 +4730,85 @@ TEST_P(StoreTest, Synthetic) {
 }
 
 #if defined(WITH_BLUESTORE)
+TEST_P(StoreTest, SyncSubmitKeepsSequencerOrder) {
+  if (string(GetParam()) != "bluestore")
+    return;
+
+  // mix sync submits with txcs forced through the kv thread, from several
+  // submitters so that runs of ready txcs are queued together
+  auto settingsBookmark = BookmarkSettings();
+  SetVal(g_conf(), "bluestore_sync_submit_transaction", "true");
+  SetVal(g_conf(), "bluestore_debug_randomize_serial_transaction", "2");
+  g_conf().apply_changes(nullptr);
+
+  int r;
+  coll_t cid;
+  ghobject_t hoid(hobject_t(sobject_t("Object 1", CEPH_NOSNAP)));
+  auto ch = store->create_new_collection(cid);
+  {
+    ObjectStore::Transaction t;
+    t.create_collection(cid, 0);
+    t.touch(cid, hoid);
+    r = queue_transaction(store, ch, std::move(t));
+    ASSERT_EQ(r, 0);
+  }
+
+  const int num_threads = 4;
+  const int per_thread = 50;
+  for (int round = 0; round < 20; ++round) {
+    // commit callbacks fire in sequencer order, so the last one to fire
+    // belongs to the txc whose value must end up on disk
+    std::mutex lock;
+    std::vector<int> committed;
+    std::vector<std::thread> submitters;
+    for (int i = 0; i < num_threads; ++i) {
+      submitters.emplace_back([&, i] {
+	for (int j = 0; j < per_thread; ++j) {
+	  int id = i * per_thread + j;
+	  ObjectStore::Transaction t;
+	  map<string, bufferlist> m;
+	  encode(id, m["k"]);
+	  t.omap_setkeys(cid, hoid, m);
+	  t.register_on_commit(new LambdaContext([&, id](int) {
+	    std::lock_guard l{lock};
+	    committed.push_back(id);
+	  }));
+	  store->queue_transaction(ch, std::move(t));
+	}
+      });
+    }
+    for (auto& th : submitters) {
+      th.join();
+    }
+    {
+      ObjectStore::Transaction t;
+      C_SaferCond c;
+      t.register_on_commit(&c);
+      store->queue_transaction(ch, std::move(t));
+      c.wait();
+    }
+    ASSERT_EQ(committed.size(), (size_t)(num_threads * per_thread));
+
+    set<string> keys = {"k"};
+    map<string, bufferlist> got;
+    r = store->omap_get_values(ch, hoid, keys, &got);
+    ASSERT_EQ(r, 0);
+    ASSERT_EQ(got.size(), 1u);
+    int last;
+    auto p = got["k"].cbegin();
+    decode(last, p);
+    ASSERT_EQ(committed.back(), last);
+  }
+
+  {
+    ObjectStore::Transaction t;
+    t.remove(cid, hoid);
+    t.remove_collection(cid);
+    r = queue_transaction(store, ch, std::move(t));
+    ASSERT_EQ(r, 0);
+  }
+}
+
 TEST_P(StoreTestSpecificAUSize, BlueFSExtenderTest) {
   if(string(GetParam()) != "bluestore")
     return;
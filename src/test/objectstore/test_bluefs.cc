@@ -203,6 +203,90 @@ TEST(BlueFS, write_read) {
   fs.umount();
 }
 
+TEST(BlueFS, read_random_sequential) {
+  uint64_t size = 1048576 * 128;
+  TempBdev bdev{size};
+  BlueFS fs(g_ceph_context);
+  ASSERT_EQ(0, fs.add_block_device(BlueFS::BDEV_DB, bdev.path, false));
+  fs.add_block_extent(BlueFS::BDEV_DB, 1048576, size - 1048576);
+  uuid_d fsid;
+  ASSERT_EQ(0, fs.mkfs(fsid, { BlueFS::BDEV_DB, false, false }));
+  ASSERT_EQ(0, fs.mount());
+  const unsigned file_size = 3 * 1048576 + 1234;
+  std::string data(file_size, 0);
+  for (unsigned i = 0; i < file_size; ++i) {
+    data[i] = 'a' + (i * 7 + i / 4096) % 26;
+  }
+  {
+    BlueFS::FileWriter *h;
+    ASSERT_EQ(0, fs.mkdir("dir"));
+    ASSERT_EQ(0, fs.open_for_write("dir", "file", &h, false));
+    h->append(data.c_str(), data.size());
+    fs.fsync(h);
+    fs.close_writer(h);
+  }
+  const PerfCounters *logger = fs.get_perf_counters();
+  uint64_t direct_reads = 0;
+  bool old = g_ceph_context->_conf.get_val<bool>("bluefs_read_random_readahead");
+  for (auto readahead : { "false", "true" }) {
+    g_ceph_context->_conf.set_val("bluefs_read_random_readahead", readahead);
+    g_ceph_context->_conf.apply_changes(nullptr);
+    BlueFS::FileReader *h;
+    ASSERT_EQ(0, fs.open_for_read("dir", "file", &h, true));
+    uint64_t fills = logger->get(l_bluefs_read_random_readahead_count);
+    uint64_t disk_reads = logger->get(l_bluefs_read_random_disk_count);
+    // scan the file in odd-sized chunks, the way a table iterator would
+    char buf[5000];
+    uint64_t off = 0;
+    while (off < file_size) {
+      int64_t r = fs.read_random(h, off, sizeof(buf), buf);
+      ASSERT_GT(r, 0);
+      ASSERT_EQ(0, memcmp(data.c_str() + off, buf, r));
+      off += r;
+    }
+    ASSERT_EQ(file_size, off);
+    fills = logger->get(l_bluefs_read_random_readahead_count) - fills;
+    disk_reads = logger->get(l_bluefs_read_random_disk_count) - disk_reads;
+    if (readahead == std::string("false")) {
+      // one direct IO per read
+      ASSERT_EQ(0u, fills);
+      ASSERT_GE(disk_reads, file_size / sizeof(buf));
+      direct_reads = disk_reads;
+    } else {
+      // the scan is detected and served from a few large buffer fills
+      ASSERT_GT(fills, 0u);
+      ASSERT_LT(fills + disk_reads, direct_reads / 10);
+    }
+    // and jump around a bit
+    for (uint64_t o : { 1048576ull - 10, 17ull, 2ull * 1048576 + 4095 }) {
+      ASSERT_EQ(100, fs.read_random(h, o, 100, buf));
+      ASSERT_EQ(0, memcmp(data.c_str() + o, buf, 100));
+    }
+    delete h;
+  }
+  {
+    // one adjacent pair of reads, as for an index block followed by a
+    // filter block, is not a scan; the third read in a row is
+    BlueFS::FileReader *h;
+    ASSERT_EQ(0, fs.open_for_read("dir", "file", &h, true));
+    char buf[100];
+    uint64_t fills = logger->get(l_bluefs_read_random_readahead_count);
+    for (uint64_t o : { 4096ull, 4196ull }) {
+      ASSERT_EQ(100, fs.read_random(h, o, 100, buf));
+      ASSERT_EQ(0, memcmp(data.c_str() + o, buf, 100));
+    }
+    ASSERT_EQ(fills, logger->get(l_bluefs_read_random_readahead_count));
+    ASSERT_EQ(100, fs.read_random(h, 4296, 100, buf));
+    ASSERT_EQ(0, memcmp(data.c_str() + 4296, buf, 100));
+    ASSERT_EQ(fills + 1, logger->get(l_bluefs_read_random_readahead_count));
+    delete h;
+  }
+  g_ceph_context->_conf.set_val("bluefs_read_random_readahead",
+				stringify((int)old));
+  g_ceph_context->_conf.apply_changes(nullptr);
+  fs.umount();
+}
+
 TEST(BlueFS, small_appends) {
   uint64_t size = 1048576 * 128;
   TempBdev bdev{size};
@@ -308,6 +308,42 @@ TEST(bluestore_blob_t, calc_csum)
   }
 }
 
+TEST(bluestore_blob_t, calc_csum_fragmented)
+{
+  // checksums must not depend on how the data is split into buffers
+  bufferptr bp(16384);
+  for (unsigned i = 0; i < bp.length(); ++i)
+    bp.c_str()[i] = (i * 7) & 0xff;
+  bufferlist contig;
+  contig.append(bp);
+  bufferlist frag;
+  for (unsigned off = 0; off < bp.length(); ) {
+    unsigned l = std::min<unsigned>(1000 + off % 3000, bp.length() - off);
+    frag.append(bufferptr(bp, off, l));
+    off += l;
+  }
+  ASSERT_LT(1u, frag.get_num_buffers());
+
+  for (unsigned csum_type = Checksummer::CSUM_NONE + 1;
+       csum_type < Checksummer::CSUM_MAX;
+       ++csum_type) {
+    bluestore_blob_t a, b;
+    a.init_csum(csum_type, 12, contig.length());
+    b.init_csum(csum_type, 12, frag.length());
+    a.calc_csum(0, contig);
+    b.calc_csum(0, frag);
+    ASSERT_EQ(a.csum_data.length(), b.csum_data.length());
+    ASSERT_EQ(0, memcmp(a.csum_data.c_str(), b.csum_data.c_str(),
+			a.csum_data.length()));
+    int bad_off;
+    uint64_t bad_csum;
+    ASSERT_EQ(0, a.verify_csum(0, frag, &bad_off, &bad_csum));
+    ASSERT_EQ(-1, bad_off);
+    ASSERT_EQ(0, b.verify_csum(0, contig, &bad_off, &bad_csum));
+    ASSERT_EQ(-1, bad_off);
+  }
+}
+
 TEST(bluestore_blob_t, csum_bench)
 {
   bufferlist bl;
@@ -1097,6 +1133,51 @@ TEST(ExtentMap, seek_lextent)
   ASSERT_EQ(em.extent_map.end(), em.seek_lextent(500));
 }
 
+TEST(OnodeCacheShard, scan_resistance)
+{
+  BlueStore store(g_ceph_context, "", 4096);
+  BlueStore::OnodeCacheShard *oc = BlueStore::OnodeCacheShard::create(
+    g_ceph_context, "lru", NULL);
+  BlueStore::BufferCacheShard *bc = BlueStore::BufferCacheShard::create(
+    g_ceph_context, "lru", NULL);
+  auto coll = ceph::make_ref<BlueStore::Collection>(&store, oc, bc, coll_t());
+  oc->set_max(8);
+
+  auto make_oid = [](unsigned i) {
+    return ghobject_t(hobject_t(sobject_t(stringify(i), CEPH_NOSNAP)));
+  };
+  auto load = [&](unsigned i) {
+    ghobject_t oid = make_oid(i);
+    BlueStore::OnodeRef o(new BlueStore::Onode(coll.get(), oid, ""));
+    coll->onode_map.add(oid, o);
+  };
+
+  // a small working set that is reused after the promote age
+  for (unsigned i = 0; i < 4; ++i) {
+    load(i);
+  }
+  // backdate the load time instead of waiting out the promote age; the
+  // release at the end of each lookup is then a reuse that promotes
+  auto age = ceph::make_timespan(g_ceph_context->_conf.get_val<double>(
+    "bluestore_onode_cache_promote_age"));
+  for (unsigned i = 0; i < 4; ++i) {
+    BlueStore::OnodeRef o = coll->onode_map.lookup(make_oid(i));
+    ASSERT_TRUE(o);
+    o->cache_added -= age + std::chrono::seconds(1);
+  }
+
+  // a scan loading many more onodes than fit in the cache
+  for (unsigned i = 100; i < 200; ++i) {
+    load(i);
+  }
+  oc->trim();
+  ASSERT_EQ(8u, oc->_get_num());
+  for (unsigned i = 0; i < 4; ++i) {
+    ASSERT_TRUE(coll->onode_map.lookup(make_oid(i)));
+  }
+  ASSERT_FALSE(coll->onode_map.lookup(make_oid(100)));
+}
+
 TEST(ExtentMap, has_any_lextents)
 {
   BlueStore store(g_ceph_context, "", 4096);
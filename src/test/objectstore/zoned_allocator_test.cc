@@ -0,0 +1,66 @@
+// -*- mode:C++; tab-width:8; c-basic-offset:2; indent-tabs-mode:t -*-
+// vim: ts=8 sw=2 smarttab
+
+#include <memory>
+#include <gtest/gtest.h>
+
+#include "global/global_context.h"
+#include "os/bluestore/ZonedAllocator.h"
+
+const uint64_t _1m = 1024 * 1024;
+
+// one conventional zone followed by three sequential 1M zones
+const uint64_t zone_size = _1m;
+const uint64_t num_zones = 4;
+const uint64_t first_seq_zone = 1;
+
+static ZonedAllocator *make_allocator()
+{
+  // see ZonedAllocator::ZonedAllocator for how the zone geometry is packed
+  // into the block size
+  int64_t block_size = 0x1000 |
+    ((zone_size / _1m) << 32) |
+    (first_seq_zone << 48);
+  auto za = new ZonedAllocator(g_ceph_context, num_zones * zone_size,
+			       block_size, "test_zoned_allocator");
+  za->set_zone_states(std::vector<zone_state_t>(num_zones));
+  return za;
+}
+
+TEST(ZonedAllocator, release_counts_dead_bytes)
+{
+  std::unique_ptr<ZonedAllocator> za(make_allocator());
+
+  PExtentVector extents;
+  ASSERT_EQ(0x3000, za->allocate(0x3000, 0x1000, 0, 0, &extents));
+  ASSERT_EQ(1u, extents.size());
+  ASSERT_EQ(first_seq_zone * zone_size, extents[0].offset);
+
+  interval_set<uint64_t> release_set;
+  release_set.insert(zone_size, 0x1000);
+  release_set.insert(zone_size + 0x2000, 0x1000);
+  za->release(release_set);
+
+  // released space stays behind the write pointer until the zone is reset
+  ASSERT_EQ(0x2000u, za->get_zone_state(1).get_num_dead_bytes());
+  ASSERT_EQ(0x3000u, za->get_zone_state(1).get_write_pointer());
+  ASSERT_EQ(0u, za->get_zone_state(2).get_num_dead_bytes());
+
+  // fill zone 1 so the next allocation goes to zone 2
+  extents.clear();
+  ASSERT_EQ(int64_t(zone_size - 0x3000),
+	    za->allocate(zone_size - 0x3000, 0x1000, 0, 0, &extents));
+  extents.clear();
+  ASSERT_EQ(0x2000, za->allocate(0x2000, 0x1000, 0, 0, &extents));
+  ASSERT_EQ(2 * zone_size, extents[0].offset);
+
+  // an extent crossing a zone boundary is split between the two zones
+  release_set.clear();
+  release_set.insert(2 * zone_size - 0x1000, 0x3000);
+  za->release(release_set);
+  ASSERT_EQ(0x3000u, za->get_zone_state(1).get_num_dead_bytes());
+  ASSERT_EQ(0x2000u, za->get_zone_state(2).get_num_dead_bytes());
+  ASSERT_EQ(0x2000u, za->get_zone_state(2).get_write_pointer());
+  ASSERT_EQ(0u, za->get_zone_state(3).get_num_dead_bytes());
+  ASSERT_EQ(0u, za->get_zone_state(0).get_num_dead_bytes());
+}
@@ -30,7 +30,11 @@ static void usage()
       "	 --threads\n"
       "	       number of threads to carry out this workload\n"
       "	 --multi-object\n"
-    "	       have each thread write to a separate object\n" << std::endl;
+      "	       have each thread write to a separate object\n"
+      "	 --omap-keys\n"
+      "	       number of omap keys to set along with each write\n"
+      "	 --omap-value-size\n"
+      "	       size in bytes of each omap value\n" << std::endl;
   generic_server_usage();
 }
 
@@ -74,10 +78,13 @@ struct Config {
   int repeats;
   int threads;
   bool multi_object;
+  int omap_keys;
+  byte_units omap_value_size;
   Config()
     : size(1048576), block_size(4096),
       repeats(1), threads(1),
-      multi_object(false) {}
+      multi_object(false),
+      omap_keys(0), omap_value_size(256) {}
 };
 
 class C_NotifyCond : public Context {
@@ -101,6 +108,12 @@ void osbench_worker(ObjectStore *os, const Config &cfg,
   bufferlist data;
   data.append(buffer::create(cfg.block_size));
 
+  // roughly what a bucket index update looks like: a few small keys
+  // written along with the data
+  bufferlist omap_value;
+  omap_value.append(buffer::create(cfg.omap_value_size));
+  omap_value.zero();
+
   dout(0) << "Writing " << cfg.size
       << " in blocks of " << cfg.block_size << dendl;
 
@@ -122,6 +135,16 @@ void osbench_worker(ObjectStore *os, const Config &cfg,
 
       auto t = new ObjectStore::Transaction;
       t->write(cid, oid, offset, count, data);
+      if (cfg.omap_keys > 0) {
+        map<string, bufferlist> keys;
+        for (int k = 0; k < cfg.omap_keys; ++k) {
+          char key[32];
+          snprintf(key, sizeof(key), "%016llx.%d",
+                   (unsigned long long)offset, k);
+          keys[key] = omap_value;
+        }
+        t->omap_setkeys(cid, oid, keys);
+      }
       tls.push_back(std::move(*t));
       delete t;
 
@@ -190,6 +213,14 @@ int main(int argc, const char *argv[])
       cfg.threads = atoi(val.c_str());
     } else if (ceph_argparse_flag(args, i, "--multi-object", (char*)nullptr)) {
       cfg.multi_object = true;
+    } else if (ceph_argparse_witharg(args, i, &val, "--omap-keys", (char*)nullptr)) {
+      cfg.omap_keys = atoi(val.c_str());
+    } else if (ceph_argparse_witharg(args, i, &val, "--omap-value-size", (char*)nullptr)) {
+      std::string err;
+      if (!cfg.omap_value_size.parse(val, &err)) {
+        derr << "error parsing omap-value-size: " << err << dendl;
+        exit(1);
+      }
     } else {
       derr << "Error: can't understand argument: " << *i << "\n" << dendl;
       exit(1);
@@ -206,6 +237,8 @@ int main(int argc, const char *argv[])
   dout(0) << "block-size " << cfg.block_size << dendl;
   dout(0) << "repeats " << cfg.repeats << dendl;
   dout(0) << "threads " << cfg.threads << dendl;
+  dout(0) << "omap-keys " << cfg.omap_keys << dendl;
+  dout(0) << "omap-value-size " << cfg.omap_value_size << dendl;
 
   auto os = std::unique_ptr<ObjectStore>(
       ObjectStore::create(g_ceph_context,
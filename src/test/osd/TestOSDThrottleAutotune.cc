@@ -0,0 +1,75 @@
+// -*- mode:C++; tab-width:8; c-basic-offset:2; indent-tabs-mode:t -*-
+// vim: ts=8 sw=2 smarttab
+
+#include <gtest/gtest.h>
+#include "common/ceph_context.h"
+#include "common/perf_counters.h"
+#include "global/global_context.h"
+#include "osd/OSD.h"
+
+// autotune_client_byte_cap is protected
+struct TestOSD : public OSD {
+  using OSD::autotune_client_byte_cap;
+};
+
+enum {
+  l_test_first = 1000,
+  l_test_lat,
+  l_test_last,
+};
+
+class ThrottleAutotune : public ::testing::Test {
+protected:
+  std::unique_ptr<PerfCounters> logger;
+  std::pair<uint64_t, uint64_t> last{0, 0};
+  const int64_t cap = 64 << 20;
+  const double target = 0.05;
+
+  void SetUp() override {
+    PerfCountersBuilder b(g_ceph_context, "throttle_autotune",
+			  l_test_first, l_test_last);
+    b.add_time_avg(l_test_lat, "lat", "dequeue latency");
+    logger.reset(b.create_perf_counters());
+  }
+
+  void feed(ceph::timespan lat, int n) {
+    for (int i = 0; i < n; ++i) {
+      logger->tinc(l_test_lat, lat);
+    }
+  }
+
+  int64_t next(int64_t cur, int64_t in_use) {
+    return TestOSD::autotune_client_byte_cap(
+      logger->get_tavg_ns(l_test_lat), &last, cap, cur, in_use, target);
+  }
+};
+
+TEST_F(ThrottleAutotune, ShrinksWhenSlow) {
+  feed(std::chrono::milliseconds(200), 10);
+  int64_t want = next(cap, 0);
+  ASSERT_EQ(cap - cap / 8, want);
+
+  // keeps shrinking while it stays slow, but not below 1/16 of the cap
+  int64_t cur = want;
+  for (int i = 0; i < 100; ++i) {
+    feed(std::chrono::milliseconds(200), 10);
+    cur = next(cur, 0);
+  }
+  ASSERT_EQ(cap / 16, cur);
+}
+
+TEST_F(ThrottleAutotune, GrowsWhenFastAndFull) {
+  int64_t cur = cap / 2;
+  feed(std::chrono::milliseconds(1), 10);
+  // not the bottleneck: leave it alone
+  ASSERT_EQ(cur, next(cur, 0));
+  feed(std::chrono::milliseconds(1), 10);
+  ASSERT_EQ(cur + cap / 16, next(cur, cur));
+}
+
+TEST_F(ThrottleAutotune, NoSamples) {
+  feed(std::chrono::milliseconds(200), 10);
+  int64_t cur = next(cap, 0);
+  // nothing new since the last tick
+  ASSERT_EQ(cur, next(cur, 0));
+}
@@ -2983,6 +2983,33 @@ TEST(pg_log_dup_t, get_key_name) {
   EXPECT_EQ("dup_0000001234.00000000000000005678", a_key_name);
 }
 
+TEST(pg_log_entry_t, encode_with_checksum) {
+  pg_log_entry_t e(pg_log_entry_t::MODIFY,
+		   hobject_t(object_t("obj"), "key", 1, 2, 3, "ns"),
+		   eversion_t(10, 100), eversion_t(9, 99), 0,
+		   osd_reqid_t(entity_name_t::CLIENT(777), 8, 1),
+		   utime_t(1, 2), 0);
+
+  // the layout must stay an encoded bufferlist followed by its crc
+  bufferlist ebl;
+  e.encode(ebl);
+  bufferlist expected;
+  encode(ebl, expected);
+  encode(ebl.crc32c(0), expected);
+
+  bufferlist bl;
+  e.encode_with_checksum(bl);
+  ASSERT_TRUE(bl.contents_equal(expected));
+
+  pg_log_entry_t d;
+  auto p = bl.cbegin();
+  d.decode_with_checksum(p);
+  ASSERT_TRUE(p.end());
+  ASSERT_EQ(e.version, d.version);
+  ASSERT_EQ(e.soid, d.soid);
+  ASSERT_EQ(e.reqid, d.reqid);
+}
+
 
 // This tests trim() to make copies of
 // 2 log entries (107, 106) and 3 additional for a total
@@ -0,0 +1,83 @@
+// -*- mode:C++; tab-width:8; c-basic-offset:2; indent-tabs-mode:t -*-
+// vim: ts=8 sw=2 smarttab
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "common/ceph_argparse.h"
+#include "global/global_context.h"
+#include "global/global_init.h"
+#include "osdc/Striper.h"
+
+using namespace std::chrono;
+
+template <typename F>
+static void bench(const char *name, uint64_t iters, F&& f)
+{
+  auto start = steady_clock::now();
+  for (uint64_t i = 0; i < iters; ++i) {
+    f(i);
+  }
+  auto ns = duration_cast<nanoseconds>(steady_clock::now() - start).count();
+  std::cout << name << ": " << (double)ns / iters << " ns/call" << std::endl;
+}
+
+static void usage(const char *name)
+{
+  std::cout << name << " [iterations]\n"
+	    << "\t time Striper::file_to_extents() for small I/O\n";
+}
+
+int main(int argc, const char **argv)
+{
+  std::vector<const char*> args;
+  argv_to_vec(argc, argv, args);
+  auto cct = global_init(nullptr, args, CEPH_ENTITY_TYPE_CLIENT,
+			 CODE_ENVIRONMENT_UTILITY,
+			 CINIT_FLAG_NO_DEFAULT_CONFIG_FILE);
+  common_init_finish(g_ceph_context);
+
+  uint64_t iters = 1000000;
+  if (args.size() > 1) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  } else if (args.size() == 1) {
+    iters = strtoull(args[0], nullptr, 10);
+  }
+
+  file_layout_t plain;
+  plain.object_size = 4 << 20;
+  plain.stripe_unit = 4 << 20;
+  plain.stripe_count = 1;
+
+  file_layout_t striped;
+  striped.object_size = 4 << 20;
+  striped.stripe_unit = 64 << 10;
+  striped.stripe_count = 8;
+
+  // 4k I/O walking through a 1 GiB image
+  auto off = [](uint64_t i) { return (i * 4096 * 17) % (1ull << 30); };
+
+  bench("lightweight, stripe_count=1", iters, [&](uint64_t i) {
+    striper::LightweightObjectExtents ex;
+    Striper::file_to_extents(g_ceph_context, &plain, off(i), 4096, 0, 0, &ex);
+  });
+  bench("lightweight, stripe_count=8", iters, [&](uint64_t i) {
+    striper::LightweightObjectExtents ex;
+    Striper::file_to_extents(g_ceph_context, &striped, off(i), 4096, 0, 0,
+			     &ex);
+  });
+  bench("vector<ObjectExtent>, stripe_count=1", iters, [&](uint64_t i) {
+    std::vector<ObjectExtent> ex;
+    Striper::file_to_extents(g_ceph_context, "rbd_data.1234.%016llx", &plain,
+			     off(i), 4096, 0, ex);
+  });
+  bench("map<object_t, ...>, stripe_count=1", iters, [&](uint64_t i) {
+    std::map<object_t, std::vector<ObjectExtent>> ex;
+    Striper::file_to_extents(g_ceph_context, "rbd_data.1234.%016llx", &plain,
+			     off(i), 4096, 0, ex);
+  });
+  return 0;
+}
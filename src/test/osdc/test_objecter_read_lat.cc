@@ -0,0 +1,39 @@
+// -*- mode:C++; tab-width:8; c-basic-offset:2; indent-tabs-mode:t -*-
+// vim: ts=8 sw=2 smarttab
+
+#include "gtest/gtest.h"
+#include "osdc/Objecter.h"
+
+TEST(ObjecterReadLat, PicksLowerAverage)
+{
+  EXPECT_EQ(1, Objecter::pick_by_read_lat(0, 2000000, 1, 500000));
+  EXPECT_EQ(0, Objecter::pick_by_read_lat(0, 500000, 1, 2000000));
+}
+
+TEST(ObjecterReadLat, TieKeepsFirstChoice)
+{
+  EXPECT_EQ(2, Objecter::pick_by_read_lat(2, 700000, 0, 700000));
+}
+
+TEST(ObjecterReadLat, UnsampledOsdIsProbed)
+{
+  EXPECT_EQ(1, Objecter::pick_by_read_lat(0, 300000, 1, 0));
+  EXPECT_EQ(0, Objecter::pick_by_read_lat(0, 0, 1, 300000));
+}
+
+TEST(ObjecterReadLat, FoldSeedsAndConverges)
+{
+  // first sample seeds the average
+  EXPECT_EQ(800000u, Objecter::fold_read_lat(0, 800000));
+
+  // sub-millisecond samples are kept, not rounded away
+  uint64_t avg = Objecter::fold_read_lat(0, 150000);
+  EXPECT_EQ(150000u, avg);
+
+  // a slow replica's average moves 1/8 of the way per sample
+  avg = Objecter::fold_read_lat(800000, 1600000);
+  EXPECT_EQ(900000u, avg);
+  for (int i = 0; i < 100; ++i)
+    avg = Objecter::fold_read_lat(avg, 1600000);
+  EXPECT_NEAR(1600000.0, (double)avg, 1600000 * 0.01);
+}
@@ -252,4 +252,44 @@ TEST(PerfCounters, read_avg) {
   std::thread t2(counters_readavg_test, fake_pf);
   t2.join();
   t1.join();
-}
\ No newline at end of file
+}
+enum {
+  TEST_PERFCOUNTERS4_ELEMENT_FIRST = 500,
+  TEST_PERFCOUNTERS4_ELEMENT_OPS,
+  TEST_PERFCOUNTERS4_ELEMENT_LAT,
+  TEST_PERFCOUNTERS4_ELEMENT_LAST,
+};
+
+TEST(PerfCounters, Sharded) {
+  PerfCountersBuilder bld(g_ceph_context, "test_perfcounter_4",
+      TEST_PERFCOUNTERS4_ELEMENT_FIRST, TEST_PERFCOUNTERS4_ELEMENT_LAST);
+  bld.set_sharded_default(true);
+  bld.add_u64_counter(TEST_PERFCOUNTERS4_ELEMENT_OPS, "ops");
+  bld.add_time_avg(TEST_PERFCOUNTERS4_ELEMENT_LAT, "lat");
+  std::shared_ptr<PerfCounters> fake_pf(bld.create_perf_counters());
+
+  utime_t t;
+  t.set_from_double(0.000000001);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; i++) {
+    threads.emplace_back([fake_pf, t] {
+      for (int j = 0; j < 10000; j++) {
+	fake_pf->inc(TEST_PERFCOUNTERS4_ELEMENT_OPS);
+	fake_pf->tinc(TEST_PERFCOUNTERS4_ELEMENT_LAT, t);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(80000u, fake_pf->get(TEST_PERFCOUNTERS4_ELEMENT_OPS));
+  auto [count, sum] = fake_pf->get_tavg_ns(TEST_PERFCOUNTERS4_ELEMENT_LAT);
+  ASSERT_EQ(80000u, count);
+  ASSERT_EQ(80000u, sum);
+
+  fake_pf->set(TEST_PERFCOUNTERS4_ELEMENT_OPS, 5);
+  ASSERT_EQ(5u, fake_pf->get(TEST_PERFCOUNTERS4_ELEMENT_OPS));
+  fake_pf->reset();
+  ASSERT_EQ(0u, fake_pf->get(TEST_PERFCOUNTERS4_ELEMENT_OPS));
+  ASSERT_EQ(0u, fake_pf->get_tavg_ns(TEST_PERFCOUNTERS4_ELEMENT_LAT).first);
+}
@@ -22,6 +22,34 @@ TEST(Striper, Stripe1)
   ASSERT_EQ(94208u, ex[2].truncate_size);
 }
 
+TEST(Striper, SingleObject)
+{
+  file_layout_t l;
+
+  l.object_size = 4194304;
+  l.stripe_unit = 4194304;
+  l.stripe_count = 1;
+
+  striper::LightweightObjectExtents ex;
+  Striper::file_to_extents(g_ceph_context, &l, 3 * 4194304 + 8192, 4096,
+                           3 * 4194304, 100, &ex);
+  ASSERT_EQ(1u, ex.size());
+  ASSERT_EQ(3u, ex[0].object_no);
+  ASSERT_EQ(8192u, ex[0].offset);
+  ASSERT_EQ(4096u, ex[0].length);
+  ASSERT_EQ(0u, ex[0].truncate_size);
+  ASSERT_EQ(1u, ex[0].buffer_extents.size());
+  ASSERT_EQ(100u, ex[0].buffer_extents[0].first);
+  ASSERT_EQ(4096u, ex[0].buffer_extents[0].second);
+
+  // a contiguous follow-up extends the same object extent
+  Striper::file_to_extents(g_ceph_context, &l, 3 * 4194304 + 12288, 4096,
+                           3 * 4194304, 4196, &ex);
+  ASSERT_EQ(1u, ex.size());
+  ASSERT_EQ(8192u, ex[0].length);
+  ASSERT_EQ(2u, ex[0].buffer_extents.size());
+}
+
 TEST(Striper, EmptyPartialResult)
 {
   file_layout_t l;
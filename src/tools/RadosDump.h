@@ -386,12 +386,10 @@ class RadosDump
         footer ft;
         ft.encode(blftr);
 
-        int ret = blhdr.write_fd(fd);
-        if (ret) return ret;
-        ret = bl.write_fd(fd);
-        if (ret) return ret;
-        ret = blftr.write_fd(fd);
-        return ret;
+        // one writev() per section instead of three write()s
+        blhdr.claim_append(bl);
+        blhdr.claim_append(blftr);
+        return blhdr.write_fd(fd);
       }
 
     int write_simple(sectiontype_t type, int fd)
@@ -35,8 +35,11 @@ ObjectCacheStore::ObjectCacheStore(CephContext *cct)
   uint64_t max_inflight_ops =
     m_cct->_conf.get_val<uint64_t>("immutable_object_cache_max_inflight_ops");
 
+  uint64_t promote_threshold =
+    m_cct->_conf.get_val<uint64_t>("immutable_object_cache_promote_threshold");
+
   m_policy = new SimplePolicy(m_cct, cache_max_size, max_inflight_ops,
-                              cache_watermark);
+                              cache_watermark, promote_threshold);
 }
 
 ObjectCacheStore::~ObjectCacheStore() {
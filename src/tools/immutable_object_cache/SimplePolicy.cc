@@ -4,6 +4,8 @@
 #include "common/debug.h"
 #include "SimplePolicy.h"
 
+#include <algorithm>
+
 #define dout_context g_ceph_context
 #define dout_subsys ceph_subsys_immutable_obj_cache
 #undef dout_prefix
@@ -13,14 +15,24 @@
 namespace ceph {
 namespace immutable_obj_cache {
 
+namespace {
+
+// bound the memory used to remember objects missed only a few times
+const size_t MAX_MISS_HISTORY = 1 << 16;
+
+} // anonymous namespace
+
 SimplePolicy::SimplePolicy(CephContext *cct, uint64_t cache_size,
-                           uint64_t max_inflight, double watermark)
+                           uint64_t max_inflight, double watermark,
+                           uint64_t promote_threshold)
   : cct(cct), m_watermark(watermark), m_max_inflight_ops(max_inflight),
-    m_max_cache_size(cache_size) {
+    m_max_cache_size(cache_size),
+    m_promote_threshold(std::max<uint64_t>(promote_threshold, 1)) {
 
   ldout(cct, 20) << "max cache size= " << m_max_cache_size
                  << " ,watermark= " << m_watermark
-                 << " ,max inflight ops= " << m_max_inflight_ops << dendl;
+                 << " ,max inflight ops= " << m_max_inflight_ops
+                 << " ,promote threshold= " << m_promote_threshold << dendl;
 
   m_cache_size = 0;
 
@@ -46,8 +58,26 @@ cache_status_t SimplePolicy::alloc_entry(std::string file_name) {
     return OBJ_CACHE_SKIP;
   }
 
+  if (m_promote_threshold > 1) {
+    auto count_it = m_miss_count.find(file_name);
+    if (count_it == m_miss_count.end()) {
+      if (m_miss_count.size() >= MAX_MISS_HISTORY) {
+        m_miss_count.clear();
+      }
+      count_it = m_miss_count.emplace(file_name, 0).first;
+    }
+    if (++count_it->second < m_promote_threshold) {
+      ldout(cct, 20) << "not promoting yet: " << file_name
+                     << " misses=" << count_it->second << dendl;
+      return OBJ_CACHE_SKIP;
+    }
+  }
+
   if ((m_cache_size < m_max_cache_size) &&
       (inflight_ops < m_max_inflight_ops)) {
+    if (m_promote_threshold > 1) {
+      m_miss_count.erase(file_name);
+    }
     Entry* entry = new Entry();
     ceph_assert(entry != nullptr);
     m_cache_map[file_name] = entry;
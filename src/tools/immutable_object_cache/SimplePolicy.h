@@ -18,7 +18,7 @@ namespace immutable_obj_cache {
 class SimplePolicy : public Policy {
  public:
   SimplePolicy(CephContext *cct, uint64_t block_num, uint64_t max_inflight,
-               double watermark);
+               double watermark, uint64_t promote_threshold = 1);
   ~SimplePolicy();
 
   cache_status_t lookup_object(std::string file_name);
@@ -52,6 +52,7 @@ class SimplePolicy : public Policy {
   double m_watermark;
   uint64_t m_max_inflight_ops;
   uint64_t m_max_cache_size;
+  uint64_t m_promote_threshold;
   std::atomic<uint64_t> inflight_ops = 0;
 
   std::unordered_map<std::string, Entry*> m_cache_map;
@@ -60,6 +61,11 @@ class SimplePolicy : public Policy {
 
   std::atomic<uint64_t> m_cache_size;
 
+  // misses seen so far for objects not (yet) admitted, protected by
+  // m_cache_map_lock; forgotten all at once when it grows too large so
+  // that only objects read again within a bounded window get promoted
+  std::unordered_map<std::string, uint64_t> m_miss_count;
+
   LRU m_promoted_lru;
 };
 
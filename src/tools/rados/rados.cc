@@ -48,6 +48,8 @@
 #include <climits>
 #include <locale>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 #include "cls/lock/cls_lock_client.h"
 #include "include/compat.h"
@@ -199,6 +201,9 @@ void usage(ostream& out)
 "   --all\n"
 "        Use with ls to list objects in all namespaces\n"
 "        Put in CEPH_ARGS environment variable to make this the default\n"
+"   --parallel N\n"
+"        Use with ls to list N slices of the pool's PGs concurrently;\n"
+"        objects are not listed in PG order\n"
 "   --default\n"
 "        Use with ls to list objects in default namespace\n"
 "        Takes precedence over --all in case --all is in environment\n"
@@ -415,6 +420,76 @@ void dump_name(Formatter *formatter, const librados::NObjectIterator& i, [[maybe
 
 } // namespace detail
 
+// list the pool with `workers` threads, each walking its own slice of
+// the PGs; objects come out grouped per batch, in no particular order
+static int list_objects_parallel(IoCtx& io_ctx, unsigned workers,
+				 bool wildcard,
+				 [[maybe_unused]] bool use_striper,
+				 Formatter *formatter, ostream& out)
+{
+  std::mutex lock;
+  int ret = 0;
+  std::vector<std::thread> threads;
+  for (unsigned n = 0; n < workers; ++n) {
+    threads.emplace_back([&, n] {
+      IoCtx ioctx;
+      ioctx.dup(io_ctx);
+      ObjectCursor begin, end;
+      ioctx.object_list_slice(ioctx.object_list_begin(),
+			      ioctx.object_list_end(),
+			      n, workers, &begin, &end);
+      while (begin < end) {
+	std::vector<ObjectItem> items;
+	int r = ioctx.object_list(begin, end, 1024, {}, &items, &begin);
+	std::lock_guard l{lock};
+	if (r < 0) {
+	  cerr << "error listing objects: " << cpp_strerror(r) << std::endl;
+	  ret = r;
+	  return;
+	}
+	if (ret < 0) {
+	  return;
+	}
+	for (auto& item : items) {
+	  std::string name = item.oid;
+#ifdef WITH_LIBRADOSSTRIPER
+	  if (use_striper) {
+	    // only list the first object of each striped object
+	    size_t len = name.length();
+	    if (len <= 17 ||
+		name.compare(len - 17, 17, ".0000000000000000") != 0)
+	      continue;
+	    name.resize(len - 17);
+	  }
+#endif
+	  if (!formatter) {
+	    if (wildcard)
+	      out << item.nspace << "\t";
+	    out << name;
+	    if (item.locator.size())
+	      out << "\t" << item.locator;
+	    out << std::endl;
+	  } else {
+	    formatter->open_object_section("object");
+	    formatter->dump_string("namespace", item.nspace);
+	    formatter->dump_string("name", name);
+	    if (item.locator.size())
+	      formatter->dump_string("locator", item.locator);
+	    formatter->close_section();
+	  }
+	}
+	// keep at most one page buffered in the formatter
+	if (formatter)
+	  formatter->flush(out);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  return ret;
+}
+
 unsigned default_op_size = 1 << 22;
 static const unsigned MAX_OMAP_BYTES_PER_REQUEST = 1 << 10;
 
@@ -1849,6 +1924,7 @@ static int rados_tool_common(const std::map < std::string, std::string > &opts,
   const char *target_pool_name = NULL;
   string oloc, target_oloc, nspace, target_nspace;
   int concurrent_ios = 16;
+  int ls_workers = 1;
   unsigned op_size = default_op_size;
   unsigned object_size = 0;
   unsigned max_objects = 0;
@@ -1926,6 +2002,12 @@ static int rados_tool_common(const std::map < std::string, std::string > &opts,
       return -EINVAL;
     }
   }
+  i = opts.find("parallel");
+  if (i != opts.end()) {
+    if (rados_sistrtoll(i, &ls_workers) || ls_workers < 1) {
+      return -EINVAL;
+    }
+  }
   i = opts.find("run-name");
   if (i != opts.end()) {
     run_name = i->second;
@@ -2415,7 +2497,14 @@ static int rados_tool_common(const std::map < std::string, std::string > &opts,
     else
       outstream = new ofstream(output);
 
-    {
+    if (ls_workers > 1 && !pgid) {
+      if (formatter)
+        formatter->open_array_section("objects");
+      ret = list_objects_parallel(io_ctx, ls_workers, wildcard, use_striper,
+				  formatter.get(), *outstream);
+      if (ret < 0)
+	return 1;
+    } else {
       if (formatter)
         formatter->open_array_section("objects");
       try {
@@ -3998,6 +4087,8 @@ int main(int argc, const char **argv)
     } else if (ceph_argparse_flag(args, i, "--striper" , (char *)NULL)) {
       opts["striper"] = "true";
 #endif
+    } else if (ceph_argparse_witharg(args, i, &val, "--parallel", (char*)NULL)) {
+      opts["parallel"] = val;
     } else if (ceph_argparse_witharg(args, i, &val, "-t", "--concurrent-ios", (char*)NULL)) {
       opts["concurrent-ios"] = val;
     } else if (ceph_argparse_witharg(args, i, &val, "--block-size", (char*)NULL)) {
@@ -9,6 +9,7 @@
 #include "common/errno.h"
 #include "common/Throttle.h"
 #include "include/encoding.h"
+#include "include/interval_set.h"
 #include <iostream>
 #include <fcntl.h>
 #include <stdlib.h>
@@ -515,12 +516,52 @@ static int do_export_v2(librbd::Image& image, librbd::image_info_t &info, int fd
   return r;
 }
 
+static int allocated_extents_callback(uint64_t offset, size_t len, int exists,
+                                      void *arg) {
+  auto extents = reinterpret_cast<interval_set<uint64_t> *>(arg);
+  if (exists) {
+    extents->union_insert(offset, len);
+  }
+  return 0;
+}
+
+// With a valid fast-diff map, the objects backing the image can be found
+// without touching them.  Returns false if the map cannot be used, in which
+// case every period has to be read.
+static bool get_allocated_extents(librbd::Image& image, uint64_t size,
+                                  interval_set<uint64_t> *extents)
+{
+  uint64_t features;
+  uint64_t flags;
+  if (image.features(&features) < 0 ||
+      (features & RBD_FEATURE_FAST_DIFF) == 0 ||
+      image.get_flags(&flags) < 0 ||
+      (flags & RBD_FLAG_FAST_DIFF_INVALID) != 0) {
+    return false;
+  }
+
+  int r = image.diff_iterate2(nullptr, 0, size, true, true,
+                              &allocated_extents_callback, extents);
+  if (r < 0) {
+    extents->clear();
+    return false;
+  }
+  return true;
+}
+
 static int do_export_v1(librbd::Image& image, librbd::image_info_t &info,
                         int fd, uint64_t period, int max_concurrent_ops,
                         utils::ProgressContext &pc)
 {
   int r = 0;
   size_t file_size = 0;
+
+  // a sparse destination does not need the unallocated periods: they are
+  // left as holes by the final ftruncate
+  interval_set<uint64_t> extents;
+  bool sparse = (fd != STDOUT_FILENO &&
+                 get_allocated_extents(image, info.size, &extents));
+
   OrderedThrottle throttle(max_concurrent_ops, false);
   for (uint64_t offset = 0; offset < info.size; offset += period) {
     if (throttle.pending_error()) {
@@ -528,6 +569,10 @@ static int do_export_v1(librbd::Image& image, librbd::image_info_t &info,
     }
 
     uint64_t length = min(period, info.size - offset);
+    if (sparse && !extents.intersects(offset, length)) {
+      pc.update_progress(offset, info.size);
+      continue;
+    }
     C_Export *ctx = new C_Export(throttle, image, file_size + offset, offset,
                                  length, fd);
     ctx->send();